@@ -1,6 +1,16 @@
+// tree_view maps snapshots on Windows too, as it does on other platforms
+#define SVO_WIN32_FILE_MAPPING
 
 #include "rapid_svo.h"
 #include <sstream>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
 
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
@@ -24,6 +34,49 @@ static std::string add_thousand_separators(std::string value, char thousandSep =
     return value;
 }
 
+static void svo_report(std::stringstream& strbuf, ankerl::nanobench::Bench& svo_bench, uint64_t count, const char* unit = "voxel")
+{
+    auto& results = svo_bench.results();
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        auto r = results[i];
+        auto time_per_op_ns = r.median(ankerl::nanobench::Result::Measure::elapsed) * 1e9;
+        double op_per_s = 1e9 / time_per_op_ns; 
+        uint64_t voxel_count = op_per_s * static_cast<double>(count);
+        strbuf << std::fixed << add_thousand_separators(std::to_string(voxel_count)) << " " << unit << "s/s\t| ";
+        strbuf << std::fixed << std::setprecision(2) << time_per_op_ns << " ns/op\t| ";
+        strbuf << std::fixed << std::setprecision(2) << (time_per_op_ns/count) << " ns/" << unit << "\t| ";
+        strbuf << std::fixed << op_per_s << " op/s\t| ";
+        strbuf << r.config().mBenchmarkName << " as " << count << " " << unit << "s/op";
+        strbuf << "\n";
+    }
+}
+
+// heightmap like surface, two voxels thick, the typical sparse terrain distribution
+template<typename SVO_TREE_T>
+static std::vector<typename SVO_TREE_T::spatial_voxel> svo_surface_voxels(int extent)
+{
+    using svo_component_type = rapid_svo::morton_util<SVO_TREE_T::get_type()>::component_type;
+
+    std::vector<typename SVO_TREE_T::spatial_voxel> voxels{};
+    for(int x = 0; x < extent; ++x){
+        for(int z = 0; z < extent; ++z){
+            const double wave = std::sin(x * 0.11) * std::cos(z * 0.07) + 1.0;
+            const int height = static_cast<int>(extent / 4 + wave * extent / 8);
+            for(int y = height - 1; y <= height; ++y){
+                typename SVO_TREE_T::spatial_voxel voxel;
+                typename SVO_TREE_T::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                voxel.encode_position(&pos_[0]); 
+                voxels.push_back(voxel);
+            }
+        }
+    }
+    return voxels;
+}
+
 template<typename SVO_TREE_T>
 static void svo_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
 {
@@ -58,7 +111,9 @@ static void svo_bench(std::stringstream& strbuf, std::string name, int extent, i
         strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
         svo_tree tree{};
         tree.alloc_bulk(voxels2.data(), static_cast<uint32_t>(voxels2.size()));
+        const auto frozen_tree = tree.freeze();
         strbuf << " \x1B[33m" << (tree.byte_size() / 1000.0) << " KB";
+        strbuf << ", frozen " << (frozen_tree.byte_size() / 1000.0) << " KB";
         strbuf << ", max_depth=" << svo_tree::MAX_DEPTH;
         strbuf << "\033[0m" << "\n";
 
@@ -90,6 +145,15 @@ static void svo_bench(std::stringstream& strbuf, std::string name, int extent, i
         svo_bench.epochs(max_epochs);
         svo_bench.minEpochIterations(max_iters);
         svo_bench.run("svo_alloc(N^3)", [&] {
+            svo_tree tree2{};
+            for(auto& voxel : voxels) {
+                typename svo_tree::vector_type pos_{0,0,0};
+                voxel.decode_position(&pos_[0]);
+                tree2.alloc(pos_, voxel._data);
+            }
+        });
+
+        svo_bench.run("svo_alloc_bulk(N^3)", [&] {
             svo_tree tree2{};
             tree2.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
         });
@@ -105,6 +169,33 @@ static void svo_bench(std::stringstream& strbuf, std::string name, int extent, i
             }
         });
 
+        svo_bench.run("svo_frozen_get(N^3)", [&] {
+            for(int i = 0; i < count; ++i) {
+                doNotOptimizeAway(frozen_tree.get(positions[i]));
+            }
+        });
+
+        auto random_positions = positions;
+        std::shuffle(random_positions.begin(), random_positions.end(), std::mt19937{ 1234 });
+
+        svo_bench.run("svo_get_random(N^3)", [&] {
+            for(int i = 0; i < count; ++i) {
+                doNotOptimizeAway(tree.get(random_positions[i]));
+            }
+        });
+
+        std::vector<typename svo_tree::voxel_format*> found_voxels(count);
+
+        svo_bench.run("svo_get_bulk(N^3)", [&] {
+            tree.get_bulk(positions.data(), found_voxels.data(), found_voxels.size());
+            doNotOptimizeAway(found_voxels.data());
+        });
+
+        svo_bench.run("svo_get_bulk_random(N^3)", [&] {
+            tree.get_bulk(random_positions.data(), found_voxels.data(), found_voxels.size());
+            doNotOptimizeAway(found_voxels.data());
+        });
+
         svo_bench.epochs(1);
         svo_bench.minEpochIterations(1);
         svo_bench.run("svo_dealloc(N^3)", [&] {
@@ -112,91 +203,1696 @@ static void svo_bench(std::stringstream& strbuf, std::string name, int extent, i
                 doNotOptimizeAway(tree.dealloc(positions[i]));
             }
         });
+
+        const typename svo_tree::vector_type box_max(extent - 1, extent - 1, extent - 1);
+        tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+        svo_bench.run("svo_dealloc_box(N^3)", [&] {
+            doNotOptimizeAway(tree.dealloc_box(typename svo_tree::vector_type(0, 0, 0), box_max));
+        });
+
+        // a box off the node grid, only the nodes along its faces are descended
+        const typename svo_tree::vector_type inner_min(1, 1, 1);
+        const typename svo_tree::vector_type inner_max(extent - 2, extent - 2, extent - 2);
+        tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+        svo_bench.run("svo_dealloc_box(inner N^3)", [&] {
+            doNotOptimizeAway(tree.dealloc_box(inner_min, inner_max));
+        });
+
+        tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+        svo_bench.run("svo_clear(N^3)", [&] {
+            doNotOptimizeAway(tree.clear());
+        });
     }
 
-    const auto count = extent*extent*extent; 
-    auto& results = svo_bench.results();
-    for(int i = 0; i < results.size(); ++i)
+    svo_report(strbuf, svo_bench, extent*extent*extent);
+}
+
+template<typename SVO_TREE_T>
+static void svo_sparse_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    using svo_tree = SVO_TREE_T;
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    const auto frozen_tree = tree.freeze();
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels";
+    strbuf << ", " << (tree.byte_size() / 1000.0) << " KB";
+    strbuf << ", frozen " << (frozen_tree.byte_size() / 1000.0) << " KB";
+    strbuf << "\033[0m" << "\n";
+
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                positions.emplace_back(x,y,z);
+            }
+        }
+    }
+
+    svo_bench.run("svo_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(tree.get(position));
+        }
+    });
+
+    svo_bench.run("svo_frozen_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(frozen_tree.get(position));
+        }
+    });
+
+    const typename svo_tree::vector_type box_max(extent - 1, extent - 1, extent - 1);
+    svo_bench.run("svo_for_each_in_box(N^3)", [&] {
+        tree.for_each_in_box(typename svo_tree::vector_type(0, 0, 0), box_max, 
+            [](const typename svo_tree::vector_type&, typename svo_tree::voxel_format& voxel) {
+                doNotOptimizeAway(&voxel);
+            });
+    });
+
+    svo_bench.run("svo_for_each_voxel(N^3)", [&] {
+        tree.for_each_voxel_morton([](typename svo_tree::morton_type morton, typename svo_tree::voxel_format& voxel) {
+            doNotOptimizeAway(morton);
+            doNotOptimizeAway(&voxel);
+        });
+    });
+
+    svo_report(strbuf, svo_bench, positions.size());
+}
+
+template<typename SVO_TREE_T>
+static void svo_neighborhood_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels";
+    strbuf << "\033[0m" << "\n";
+
+    // neighbourhoods of every surface voxel, the typical physics / cellular rule access
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(auto& voxel : voxels) {
+        typename svo_tree::vector_type pos_{0,0,0};
+        voxel.decode_position(&pos_[0]);
+        positions.push_back(pos_);
+    }
+
+    std::array<typename svo_tree::voxel_format*, 27> out{};
+
+    svo_bench.run("svo_get_x27(voxels)", [&] {
+        for(const auto& position : positions) {
+            for(int dz = -1; dz <= 1; ++dz){
+                for(int dy = -1; dy <= 1; ++dy){
+                    for(int dx = -1; dx <= 1; ++dx){
+                        const int x = position[0] + dx, y = position[1] + dy, z = position[2] + dz;
+                        typename svo_tree::vector_type neighbor_{
+                            (svo_component_type)x,
+                            (svo_component_type)y,
+                            (svo_component_type)z};
+                        out[(dx+1) + 3*(dy+1) + 9*(dz+1)] = 
+                            x < 0 || y < 0 || z < 0 || x >= extent || y >= extent || z >= extent ? nullptr : tree.get(neighbor_);
+                    }
+                }
+            }
+            doNotOptimizeAway(out.data());
+        }
+    });
+
+    svo_bench.run("svo_get_neighborhood(voxels)", [&] {
+        for(const auto& position : positions) {
+            tree.get_neighborhood(position, out.data());
+            doNotOptimizeAway(out.data());
+        }
+    });
+
+    svo_bench.run("svo_get_face_neighborhood(voxels)", [&] {
+        for(const auto& position : positions) {
+            tree.get_face_neighborhood(position, out.data());
+            doNotOptimizeAway(out.data());
+        }
+    });
+
+    svo_report(strbuf, svo_bench, positions.size());
+}
+
+template<typename SVO_TREE_T>
+static void svo_overlap_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    // two solid spheres as rigid bodies, b is moved so that only its cap touches a
+    std::vector<typename svo_tree::spatial_voxel> voxels{};
+    const float radius = extent * 0.5f - 1.0f;
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                const glm::vec3 d(x - extent * 0.5f + 0.5f, y - extent * 0.5f + 0.5f, z - extent * 0.5f + 0.5f);
+                if(glm::length(d) > radius) {
+                    continue; }
+                typename svo_tree::spatial_voxel voxel;
+                typename svo_tree::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                voxel.encode_position(&pos_[0]); 
+                voxels.push_back(voxel);
+            }
+        }
+    }
+
+    svo_tree body_a{};
+    svo_tree body_b{};
+    body_a.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    body_b.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    const glm::ivec3 offset(static_cast<int>(radius * 1.9f), 3, 1);
+
+    uint32_t contacts = 0;
+    svo_tree::for_each_overlap(body_a, body_b, offset, [&](const auto&, auto&, auto&) { ++contacts; return true; });
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels per body, " << contacts << " contacts";
+    strbuf << "\033[0m" << "\n";
+
+    svo_bench.run("svo_probe_overlap(bodies)", [&] {
+        uint32_t found = 0;
+        body_b.for_each_voxel([&](const typename svo_tree::vector_type& position, typename svo_tree::voxel_format&) {
+            const int x = position[0] + offset[0], y = position[1] + offset[1], z = position[2] + offset[2];
+            if(x < 0 || y < 0 || z < 0 || x >= extent || y >= extent || z >= extent) {
+                return; }
+            typename svo_tree::vector_type pos_{
+                (svo_component_type)x,
+                (svo_component_type)y,
+                (svo_component_type)z};
+            found += body_a.get(pos_) != nullptr;
+        });
+        doNotOptimizeAway(found);
+    });
+
+    svo_bench.run("svo_for_each_overlap(bodies)", [&] {
+        uint32_t found = 0;
+        svo_tree::for_each_overlap(body_a, body_b, offset, [&](const auto&, auto&, auto&) { ++found; return true; });
+        doNotOptimizeAway(found);
+    });
+
+    svo_report(strbuf, svo_bench, 1, "test");
+}
+
+template<typename SVO_TREE_T>
+static void svo_parallel_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    std::vector<typename svo_tree::spatial_voxel> voxels{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent/2; ++y){
+            for(int z = 0; z < extent; ++z){
+                typename svo_tree::spatial_voxel voxel;
+                typename svo_tree::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                voxel.encode_position(&pos_[0]); 
+                voxels.push_back(voxel);
+            }
+        }
+    }
+
+    const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels, " << hardware_threads << " hardware threads";
+    strbuf << "\033[0m" << "\n";
+
+    svo_bench.run("svo_alloc_bulk(voxels)", [&] {
+        svo_tree tree{};
+        tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    });
+
+    for(uint32_t threads = 1; ; threads = std::min(threads * 2, hardware_threads))
     {
-        auto r = results[i];
-        auto time_per_op_ns = r.median(ankerl::nanobench::Result::Measure::elapsed) * 1e9;
-        double op_per_s = 1e9 / time_per_op_ns; 
-        uint32_t voxel_count = op_per_s * static_cast<double>(count);
-        strbuf << std::fixed << add_thousand_separators(std::to_string(voxel_count)) << " voxels/s\t| ";
-        strbuf << std::fixed << std::setprecision(2) << time_per_op_ns << " ns/op\t| ";
-        strbuf << std::fixed << std::setprecision(2) << (time_per_op_ns/count) << " ns/voxel\t| ";
-        strbuf << std::fixed << op_per_s << " op/s\t| ";
-        strbuf << r.config().mBenchmarkName << " as " << count << " voxels/op";
-        strbuf << "\n";
+        const std::string bench_name = "svo_alloc_bulk_parallel(voxels) x" + std::to_string(threads);
+        svo_bench.run(bench_name, [&] {
+            svo_tree tree{};
+            tree.alloc_bulk_parallel(voxels.data(), static_cast<uint32_t>(voxels.size()), threads);
+        });
+        if(threads == hardware_threads) {
+            break; }
     }
+
+    svo_report(strbuf, svo_bench, voxels.size());
 }
 
-int main()
+////////////////////////
+// getting a saved tree back, rebuilding it with alloc_bulk against mapping the snapshot, 
+// and the per get cost of reading through the mapping
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_snapshot_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
 {
     using namespace ankerl::nanobench;
-    
-    printf("\nRAPID_SVO running benchmarks... this will take a moment\n");
+    using svo_tree = SVO_TREE_T;
 
-    std::stringstream
-    all_results{};
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
 
-    constexpr rapid_svo::details_info details_16b_16pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 16,16,16 }};
+    auto get_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    get_bench.output(nullptr);
+    get_bench.epochs(max_epochs);
 
-    constexpr rapid_svo::details_info details_16b_32pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 32,32,32 }};
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
 
-    constexpr rapid_svo::details_info details_32b_32pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 32,32,32 }};
-           
-    constexpr rapid_svo::details_info details_32b_64pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 64,64,64 }};
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
 
-    constexpr rapid_svo::details_info details_32b_128pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 128,128,128 }};
+    const std::string path = (std::filesystem::temp_directory_path() / "rapid_svo_snapshot_bench.rsvo").string();
+    if(!tree.save(path.c_str())) {
+        strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "] " << TERMINAL_ANSI_RED("could not write " << path) << "\n";
+        return; }
 
-    constexpr rapid_svo::details_info details_32b_256pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 256,256,256 }};
+    rapid_svo::tree_view<svo_tree> view{};
+    if(!view.open(path.c_str())) {
+        strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "] " << TERMINAL_ANSI_RED("could not map " << path) << "\n";
+        return; }
 
-    constexpr rapid_svo::details_info details_32b_512pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 512,512,512 }};
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels";
+    strbuf << ", snapshot " << (std::filesystem::file_size(path) / 1000.0) << " KB";
+    strbuf << "\033[0m" << "\n";
 
-    constexpr rapid_svo::details_info details_32b_1024pow3{
-        ._discard_overflow = true,
-        ._limit_max_bounds = { 1024,1024,1024 }};
+    svo_bench.run("svo_alloc_bulk(voxels)", [&] {
+        svo_tree rebuilt{};
+        rebuilt.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    });
 
-    constexpr rapid_svo::details_info details_32b_64pow3_full_space{};
+    svo_bench.run("svo_save(voxels)", [&] {
+        doNotOptimizeAway(tree.save(path.c_str()));
+    });
 
-    constexpr rapid_svo::details_info details_32b_128pow3_full_space{};
+    // the cost of getting to the first query, pages are faulted in by the gets that touch them
+    svo_bench.run("svo_tree_view_open(voxels)", [&] {
+        rapid_svo::tree_view<svo_tree> opened{};
+        doNotOptimizeAway(opened.open(path.c_str()));
+    });
 
-    constexpr rapid_svo::details_info details_32b_256pow3_full_space{};
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                positions.emplace_back(x,y,z);
+            }
+        }
+    }
 
-    std::stringstream strbuf{};
+    get_bench.run("svo_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(tree.get(position));
+        }
+    });
 
-    //all_results << svo_bench<svo::tree<svo::morton_32b, svo::basic_voxel_format, details_32b_1024pow3>>
-    //("32b_space__svo_bench(128^3)__64bit_voxels", 128, 1,1);
-            
-    svo_bench<rapid_svo::tree<rapid_svo::morton_16b, rapid_svo::basic_voxel_format, details_16b_16pow3>>
-    (strbuf, "16b_space__svo_bench(16^3)__64bit_voxels", 16);
+    get_bench.run("svo_tree_view_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(view.get(position));
+        }
+    });
 
-    svo_bench<rapid_svo::tree<rapid_svo::morton_16b, rapid_svo::basic_voxel_format, details_16b_32pow3>>
-    (strbuf, "16b_space__svo_bench(32^3)__64bit_voxels", 32);
+    view.close();
+    std::filesystem::remove(path);
 
-    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_32pow3>>
-    (strbuf, "32b_space__svo_bench(32^3)__64bit_voxels", 32);
+    svo_report(strbuf, svo_bench, voxels.size());
+    svo_report(strbuf, get_bench, positions.size());
+}
 
-    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
-    (strbuf, "32b_space__svo_bench(64^3)__64bit_voxels", 64, 6, 10);
+////////////////////////
+// write path cost of dirty tracking, the same edits on a plain and on a tracking tree, 
+// and collecting the changed regions afterwards
+////////////////////////
+template<typename SVO_TREE_T, typename SVO_DIRTY_TREE_T>
+static void svo_dirty_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_dirty_tree = SVO_DIRTY_TREE_T;
 
-    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3>>
-    (strbuf, "32b_space__svo_bench(128^3)__64bit_voxels", 128, 1, 1);
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+
+    std::vector<typename svo_tree::morton_type> mortons{};
+    for(const auto& voxel : voxels) {
+        mortons.push_back(voxel._morton); }
+    std::shuffle(mortons.begin(), mortons.end(), std::mt19937(3));
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    svo_dirty_tree dirty_tree{};
+    dirty_tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels";
+    strbuf << "\033[0m" << "\n";
+
+    typename svo_tree::voxel_format voxel{};
+    svo_bench.run("svo_dealloc_alloc(shuffled voxels)", [&] {
+        for(const auto morton : mortons) {
+            tree.dealloc(morton);
+            tree.alloc(morton, voxel);
+        }
+    });
+
+    svo_bench.run("svo_dirty_dealloc_alloc(shuffled voxels)", [&] {
+        for(const auto morton : mortons) {
+            dirty_tree.dealloc(morton);
+            dirty_tree.alloc(morton, voxel);
+        }
+    });
+
+    // every voxel dirty, the worst case for a consume
+    uint32_t regions = 0;
+    svo_bench.run("svo_dirty_dealloc_alloc_consume(shuffled voxels)", [&] {
+        for(const auto morton : mortons) {
+            dirty_tree.dealloc(morton);
+            dirty_tree.alloc(morton, voxel);
+        }
+        dirty_tree.consume_dirty([&regions](const typename svo_dirty_tree::vector_type&, uint32_t) { ++regions; }, 
+            svo_dirty_tree::MAX_DEPTH - 4);
+    });
+    doNotOptimizeAway(regions);
+
+    svo_report(strbuf, svo_bench, voxels.size());
+}
+
+////////////////////////
+// destructible terrain, rounds of removing and re-adding random voxels scatter the blocks 
+// over the pools, gets on the churned tree against gets after compact()
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_churn_bench(std::stringstream& strbuf, std::string name, int extent, int rounds, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+
+    std::vector<typename svo_tree::morton_type> mortons{};
+    for(const auto& voxel : voxels) {
+        mortons.push_back(voxel._morton); }
+    std::sort(mortons.begin(), mortons.end());
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    auto get_all = [&] {
+        for(const auto morton : mortons) {
+            doNotOptimizeAway(tree.get(morton));
+        }
+    };
+
+    svo_bench.run("svo_get(voxels) built", get_all);
+
+    // craters, whole 8^3 regions are dug out and refilled so their blocks are freed and reused
+    std::vector<std::vector<typename svo_tree::morton_type>> regions{};
+    for(const auto morton : mortons) {
+        if(regions.empty() || (regions.back().back() >> 9) != (morton >> 9)) {
+            regions.emplace_back(); }
+        regions.back().push_back(morton);
+    }
+
+    std::mt19937 rng(11);
+    typename svo_tree::voxel_format voxel{};
+    for(int round = 0; round < rounds; ++round)
+    {
+        std::shuffle(regions.begin(), regions.end(), rng);
+        const size_t half = regions.size() / 2;
+        for(size_t i = 0; i < half; ++i) {
+            for(const auto morton : regions[i]) {
+                tree.dealloc(morton); }
+        }
+        std::shuffle(regions.begin(), regions.begin() + half, rng);
+        for(size_t i = 0; i < half; ++i) {
+            for(const auto morton : regions[i]) {
+                tree.alloc(morton, voxel); }
+        }
+    }
+
+    svo_bench.run("svo_get(voxels) churned", get_all);
+
+    svo_bench.run("svo_compact()", [&] {
+        tree.compact();
+    });
+
+    svo_bench.run("svo_get(voxels) compacted", get_all);
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels, " << rounds << " churn rounds";
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, voxels.size());
+}
+
+////////////////////////
+// morton_util::encode_n / decode_n over random positions with every kernel the CPU supports
+////////////////////////
+template<rapid_svo::bit_width BIT_WIDTH>
+static void svo_morton_bench(std::stringstream& strbuf, std::string name, size_t count, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_morton = rapid_svo::morton_util<BIT_WIDTH>;
+    using svo_component_type = typename svo_morton::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    std::mt19937 rng(5);
+    std::vector<svo_component_type> positions(count * 3);
+    for(auto& component : positions) {
+        component = static_cast<svo_component_type>(rng() % svo_morton::AXIS_MAX); }
+    std::vector<typename svo_morton::morton_type> mortons(count);
+    std::vector<svo_component_type> decoded(count * 3);
+
+    const std::array<std::pair<rapid_svo::morton_kernel, const char*>, 3> kernels{{
+        {rapid_svo::morton_kernel_lut,  "lut"},
+        {rapid_svo::morton_kernel_bmi2, "bmi2"},
+        {rapid_svo::morton_kernel_avx2, "avx2"}}};
+
+    for(const auto& [kernel, kernel_name] : kernels)
+    {
+        if(!svo_morton::kernel_supported(kernel)) {
+            continue; }
+
+        svo_bench.run(std::string("svo_encode_n(positions) ") + kernel_name, [&] {
+            svo_morton::encode_n(positions.data(), mortons.data(), count, kernel);
+            doNotOptimizeAway(mortons.back());
+        });
+
+        svo_bench.run(std::string("svo_decode_n(mortons) ") + kernel_name, [&] {
+            svo_morton::decode_n(mortons.data(), decoded.data(), count, kernel);
+            doNotOptimizeAway(decoded.back());
+        });
+    }
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << count << " positions, best kernel " << kernels[svo_morton::best_kernel()].second;
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, count, "position");
+}
+
+////////////////////////
+// occupancy of every 8^3 region of the surface terrain, counted with a get() per voxel on a 
+// plain tree against one get_lod() per region on a tree keeping aggregates, and what keeping 
+// them costs single allocs
+////////////////////////
+template<typename SVO_TREE_T, typename SVO_AGGREGATE_TREE_T>
+static void svo_lod_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_aggregate_tree = SVO_AGGREGATE_TREE_T;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    svo_aggregate_tree aggregate_tree{};
+    aggregate_tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    constexpr int REGION = 8;
+    const uint32_t region_level = svo_aggregate_tree::MAX_DEPTH - 3;
+    std::vector<typename svo_tree::vector_type> regions{};
+    for(int x = 0; x < extent; x += REGION){
+        for(int y = 0; y < extent; y += REGION){
+            for(int z = 0; z < extent; z += REGION){
+                regions.emplace_back(x,y,z);
+            }
+        }
+    }
+
+    auto lod_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    lod_bench.output(nullptr);
+    lod_bench.epochs(max_epochs);
+
+    lod_bench.run("svo_get(region voxels) occupancy", [&] {
+        uint64_t occupied = 0;
+        for(const auto& region : regions) {
+            uint32_t count = 0;
+            for(int x = 0; x < REGION; ++x){
+                for(int y = 0; y < REGION; ++y){
+                    for(int z = 0; z < REGION; ++z){
+                        typename svo_tree::vector_type pos_ = region + typename svo_tree::vector_type(x,y,z);
+                        count += tree.get(pos_) != nullptr;
+                    }
+                }
+            }
+            occupied += count > 0;
+        }
+        doNotOptimizeAway(occupied);
+    });
+
+    lod_bench.run("svo_get_lod(region) occupancy", [&] {
+        uint64_t occupied = 0;
+        for(const auto& region : regions) {
+            const auto* aggregate = aggregate_tree.get_lod(region, region_level);
+            occupied += aggregate != nullptr && aggregate->_count > 0;
+        }
+        doNotOptimizeAway(occupied);
+    });
+
+    typename svo_tree::voxel_format voxel{};
+    svo_bench.run("svo_alloc(voxels)", [&] {
+        svo_tree built{};
+        for(const auto& spatial : voxels) {
+            built.alloc(spatial._morton, voxel); }
+    });
+
+    svo_bench.run("svo_alloc(voxels) with aggregates", [&] {
+        svo_aggregate_tree built{};
+        for(const auto& spatial : voxels) {
+            built.alloc(spatial._morton, voxel); }
+    });
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " voxels, " << regions.size() << " regions";
+    strbuf << ", " << (tree.byte_size() / 1000.0) << " KB";
+    strbuf << ", " << (aggregate_tree.byte_size() / 1000.0) << " KB with aggregates";
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, lod_bench, regions.size(), "region");
+    svo_report(strbuf, svo_bench, voxels.size());
+}
+
+////////////////////////
+// an explosion of the given radius at the surface of solid ground filling the lower half of the 
+// cube, carved and filled back with a dealloc() / alloc() per voxel against one carve_sphere() / 
+// fill_sphere(), then a tunnel of the same radius carved through the ground with carve_capsule()
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_stamp_bench(std::stringstream& strbuf, std::string name, float radius, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    constexpr uint32_t extent = svo_tree::AXIS_WIDTH;
+    const typename svo_tree::vector_type ground_min(0, 0, 0);
+    const typename svo_tree::vector_type ground_max(extent - 1, extent / 2 - 1, extent - 1);
+    const auto ground = [](const typename svo_tree::vector_type&) { return typename svo_tree::voxel_format{}; };
+
+    svo_tree tree{};
+    tree.fill_box(ground_min, ground_max, ground);
+
+    const glm::vec3 centre(extent / 2.0f, extent / 2.0f, extent / 2.0f);
+    std::vector<typename svo_tree::vector_type> sphere{};
+    for(uint32_t x = 0; x < extent; ++x){
+        for(uint32_t y = 0; y < extent; ++y){
+            for(uint32_t z = 0; z < extent; ++z){
+                if(glm::length(glm::vec3(x + 0.5f, y + 0.5f, z + 0.5f) - centre) <= radius) {
+                    sphere.emplace_back(x, y, z); }
+            }
+        }
+    }
+
+    typename svo_tree::voxel_format voxel{};
+    svo_bench.run("svo_dealloc(sphere voxels)", [&] {
+        for(const auto& position : sphere) {
+            doNotOptimizeAway(tree.dealloc(position)); }
+    });
+
+    svo_bench.run("svo_alloc(sphere voxels)", [&] {
+        for(auto position : sphere) {
+            tree.alloc(position, voxel); }
+    });
+
+    svo_bench.run("svo_carve_sphere(sphere)", [&] {
+        doNotOptimizeAway(tree.carve_sphere(centre, radius));
+    });
+
+    svo_bench.run("svo_fill_sphere(sphere)", [&] {
+        doNotOptimizeAway(tree.fill_sphere(centre, radius, ground));
+    });
+
+    tree.fill_box(ground_min, ground_max, ground);
+    auto tunnel_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    tunnel_bench.output(nullptr);
+    tunnel_bench.epochs(max_epochs);
+
+    const glm::vec3 tunnel_a(0.0f, extent / 4.0f, extent / 2.0f);
+    const glm::vec3 tunnel_b(static_cast<float>(extent), extent / 4.0f, extent / 2.0f);
+    uint64_t tunnel_voxels = 0;
+    tunnel_bench.run("svo_carve_capsule(tunnel)", [&] {
+        tunnel_voxels += tree.carve_capsule(tunnel_a, tunnel_b, radius);
+    });
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << sphere.size() << " voxels in the sphere, " << tunnel_voxels << " in the tunnel";
+    strbuf << ", ground " << (tree.byte_size() / 1000.0) << " KB";
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, sphere.size());
+    svo_report(strbuf, tunnel_bench, tunnel_voxels);
+}
+
+////////////////////////
+// a hollow prefab building combined into the surface terrain, once placed on the node grid and 
+// once off it, with an alloc() / dealloc() per prefab voxel against unite() / subtract(), every 
+// run works on a fresh copy of the terrain, the copy alone is measured as well
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_csg_bench(std::stringstream& strbuf, std::string name, int extent, int prefab_extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto voxels = svo_surface_voxels<svo_tree>(extent);
+    svo_tree terrain{};
+    terrain.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    const auto wall = [](const typename svo_tree::vector_type&) { return typename svo_tree::voxel_format{}; };
+    svo_tree prefab{};
+    prefab.fill_box(typename svo_tree::vector_type(0, 0, 0), typename svo_tree::vector_type(prefab_extent - 1, prefab_extent - 1, prefab_extent - 1), wall);
+    const uint64_t prefab_voxels = prefab_extent * prefab_extent * prefab_extent - 
+        prefab.dealloc_box(typename svo_tree::vector_type(2, 2, 2), typename svo_tree::vector_type(prefab_extent - 3, prefab_extent - 3, prefab_extent - 3));
+
+    std::vector<typename svo_tree::vector_type> prefab_positions{};
+    prefab.for_each_voxel([&](const typename svo_tree::vector_type& position, typename svo_tree::voxel_format&) {
+        prefab_positions.push_back(position); });
+
+    const glm::ivec3 aligned(extent / 2, extent / 4, extent / 2);
+    const glm::ivec3 unaligned = aligned + glm::ivec3(3, 5, 1);
+
+    svo_bench.run("svo_tree copy", [&] {
+        svo_tree target = terrain;
+        doNotOptimizeAway(target.get_node_blocks_count());
+    });
+
+    for(const auto& [offset, placement] : {std::pair{aligned, "aligned"}, std::pair{unaligned, "unaligned"}})
+    {
+        svo_bench.run(std::string("svo_alloc(prefab voxels) ") + placement, [&] {
+            svo_tree target = terrain;
+            typename svo_tree::voxel_format voxel{};
+            for(const auto& position : prefab_positions) {
+                typename svo_tree::vector_type position_ = position + typename svo_tree::vector_type(offset);
+                target.alloc(position_, voxel); }
+            doNotOptimizeAway(target.get_node_blocks_count());
+        });
+
+        svo_bench.run(std::string("svo_unite(prefab) ") + placement, [&] {
+            svo_tree target = terrain;
+            target.unite(prefab, offset);
+            doNotOptimizeAway(target.get_node_blocks_count());
+        });
+
+        svo_bench.run(std::string("svo_dealloc(prefab voxels) ") + placement, [&] {
+            svo_tree target = terrain;
+            for(const auto& position : prefab_positions) {
+                doNotOptimizeAway(target.dealloc(position + typename svo_tree::vector_type(offset))); }
+        });
+
+        svo_bench.run(std::string("svo_subtract(prefab) ") + placement, [&] {
+            svo_tree target = terrain;
+            target.subtract(prefab, offset);
+            doNotOptimizeAway(target.get_node_blocks_count());
+        });
+    }
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " terrain voxels, " << prefab_voxels << " prefab voxels";
+    strbuf << ", terrain " << (terrain.byte_size() / 1000.0) << " KB";
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, prefab_voxels);
+}
+
+////////////////////////
+// a ground slab carrying a platform on four pillars, a floating sphere and loose debris, the 
+// voxels detached from one ground anchor found by a breadth-first search over get() with a 
+// hash set of visited positions against find_detached_from(), and over a region around the 
+// sphere with find_detached_in_box(), a tree with non-cubic bounds checks that both agree on 
+// a column standing off the ground against the top face of the bounds
+////////////////////////
+template<typename SVO_TREE_T, typename SVO_NON_CUBIC_TREE_T>
+static void svo_components_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_vector = typename svo_tree::vector_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    const auto solid = [](const svo_vector&) { return typename svo_tree::voxel_format{}; };
+    const int ground = extent / 16;
+    const int deck = extent * 3 / 8;
+    svo_tree tree{};
+    tree.fill_box(svo_vector(0, 0, 0), svo_vector(extent - 1, ground - 1, extent - 1), solid);
+    for(const int x : {extent / 4, extent * 3 / 4 - 8}) {
+        for(const int z : {extent / 4, extent * 3 / 4 - 8}) {
+            tree.fill_box(svo_vector(x, ground, z), svo_vector(x + 7, deck - 1, z + 7), solid); } }
+    tree.fill_box(svo_vector(extent / 8, deck, extent / 8), svo_vector(extent * 7 / 8 - 1, deck + 7, extent * 7 / 8 - 1), solid);
+
+    const glm::vec3 centre(extent / 2.0f, extent * 5 / 8.0f, extent / 2.0f);
+    tree.fill_sphere(centre, extent / 12.0f, solid);
+    std::mt19937 rng(7);
+    for(int i = 0; i < 256; ++i) {
+        const svo_vector debris(rng() % extent, ground + rng() % (deck - ground), rng() % extent);
+        tree.fill_box(debris, debris + svo_vector(1, 0, 1), solid); }
+
+    uint64_t voxel_count = 0;
+    tree.for_each_voxel([&](const svo_vector&, typename svo_tree::voxel_format&) { ++voxel_count; });
+
+    const svo_vector anchor(0, 0, 0);
+    uint64_t detached = 0;
+    svo_bench.run("bfs_get_hash_set(detached)", [&] {
+        const auto key = [](const glm::ivec3& p) { return (static_cast<uint64_t>(p.x) << 42) | (static_cast<uint64_t>(p.y) << 21) | static_cast<uint64_t>(p.z); };
+        std::unordered_set<uint64_t> visited{key(glm::ivec3(anchor))};
+        std::vector<glm::ivec3> frontier{glm::ivec3(anchor)};
+        while(!frontier.empty())
+        {
+            const glm::ivec3 position = frontier.back();
+            frontier.pop_back();
+            for(const glm::ivec3& step : {glm::ivec3(-1, 0, 0), glm::ivec3(1, 0, 0), glm::ivec3(0, -1, 0), glm::ivec3(0, 1, 0), glm::ivec3(0, 0, -1), glm::ivec3(0, 0, 1)})
+            {
+                const glm::ivec3 next = position + step;
+                if(next.x < 0 || next.y < 0 || next.z < 0 || next.x >= extent || next.y >= extent || next.z >= extent) {
+                    continue; }
+                svo_vector next_position(next);
+                if(tree.get(next_position) != nullptr && visited.insert(key(next)).second) {
+                    frontier.push_back(next); }
+            }
+        }
+        detached = 0;
+        tree.for_each_voxel([&](const svo_vector& position, typename svo_tree::voxel_format&) {
+            detached += visited.count(key(glm::ivec3(position))) == 0; });
+        doNotOptimizeAway(detached);
+    });
+
+    svo_bench.run("svo_find_detached_from(6-connected)", [&] {
+        uint64_t found = 0;
+        tree.find_detached_from(&anchor, 1, [&](const svo_vector&, typename svo_tree::voxel_format&, uint32_t) { ++found; });
+        doNotOptimizeAway(found);
+    });
+
+    svo_bench.run("svo_find_detached_from(26-connected)", [&] {
+        uint64_t found = 0;
+        tree.find_detached_from(&anchor, 1, [&](const svo_vector&, typename svo_tree::voxel_format&, uint32_t) { ++found; }, rapid_svo::connect_all);
+        doNotOptimizeAway(found);
+    });
+
+    svo_bench.run("svo_find_components(6-connected)", [&] {
+        uint64_t found = 0;
+        doNotOptimizeAway(tree.find_components([&](const svo_vector&, typename svo_tree::voxel_format&, uint32_t) { ++found; }));
+        doNotOptimizeAway(found);
+    });
+
+    const svo_vector region_min(centre - glm::vec3(extent / 8.0f));
+    const svo_vector region_max(centre + glm::vec3(extent / 8.0f));
+    svo_bench.run("svo_find_detached_in_box(region around the sphere)", [&] {
+        uint64_t found = 0;
+        tree.find_detached_in_box(region_min, region_max, &anchor, 1, [&](const svo_vector&, typename svo_tree::voxel_format&, uint32_t) { ++found; });
+        doNotOptimizeAway(found);
+    });
+
+    uint64_t found = 0;
+    const uint32_t components = tree.find_detached_from(&anchor, 1, [&](const svo_vector&, typename svo_tree::voxel_format&, uint32_t) { ++found; });
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxel_count << " voxels, " << found << " detached in " << components << " components";
+    strbuf << " (breadth-first search: " << detached << ")";
+    strbuf << "\033[0m" << "\n";
+
+    using svo_non_cubic_tree = SVO_NON_CUBIC_TREE_T;
+    using svo_non_cubic_vector = typename svo_non_cubic_tree::vector_type;
+    constexpr auto bounds = svo_non_cubic_tree::BOUNDS;
+    const auto non_cubic_solid = [](const svo_non_cubic_vector&) { return typename svo_non_cubic_tree::voxel_format{}; };
+    svo_non_cubic_tree non_cubic_tree{};
+    non_cubic_tree.fill_box(svo_non_cubic_vector(0, 0, 0), svo_non_cubic_vector(bounds[0] - 1, 0, bounds[2] - 1), non_cubic_solid);
+    non_cubic_tree.fill_box(svo_non_cubic_vector(5, bounds[1] - 3, 5), svo_non_cubic_vector(5, bounds[1] - 1, 5), non_cubic_solid);
+
+    const svo_non_cubic_vector non_cubic_anchor(0, 0, 0);
+    uint64_t non_cubic_from = 0;
+    uint64_t non_cubic_in_box = 0;
+    non_cubic_tree.find_detached_from(&non_cubic_anchor, 1, 
+        [&](const svo_non_cubic_vector&, typename svo_non_cubic_tree::voxel_format&, uint32_t) { ++non_cubic_from; });
+    non_cubic_tree.find_detached_in_box(svo_non_cubic_vector(0, 0, 0), svo_non_cubic_vector(bounds[0] - 1, bounds[1] - 1, bounds[2] - 1), &non_cubic_anchor, 1, 
+        [&](const svo_non_cubic_vector&, typename svo_non_cubic_tree::voxel_format&, uint32_t) { ++non_cubic_in_box; });
+
+    strbuf << " \x1B[33m" << bounds[0] << "x" << bounds[1] << "x" << bounds[2] << " bounds: " << non_cubic_from << " detached, " 
+        << non_cubic_in_box << " detached in box" << (non_cubic_from == 3 && non_cubic_in_box == 3 ? "" : " (MISMATCH, expected 3)");
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, voxel_count);
+}
+
+////////////////////////
+// the lower half of the cube filled solid with one value, gets over the whole cube before and 
+// after the single value subtrees are collapsed, then one write into every 8^3 region
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_collapse_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    std::vector<typename svo_tree::spatial_voxel> voxels{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent/2; ++y){
+            for(int z = 0; z < extent; ++z){
+                typename svo_tree::spatial_voxel voxel;
+                typename svo_tree::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                voxel.encode_position(&pos_[0]); 
+                voxels.push_back(voxel);
+            }
+        }
+    }
+
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                positions.emplace_back(x,y,z);
+            }
+        }
+    }
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    const uint64_t built_size = tree.byte_size();
+
+    auto get_all = [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(tree.get(position));
+        }
+    };
+
+    svo_bench.run("svo_get(N^3) built", get_all);
+
+    svo_bench.run("svo_collapse_uniform() + compact()", [&] {
+        tree.collapse_uniform();
+        tree.compact();
+    });
+    const uint64_t collapsed_size = tree.byte_size();
+
+    svo_bench.run("svo_get(N^3) collapsed", get_all);
+
+    // every write of a new value expands one path down to its voxel
+    typename svo_tree::voxel_format edit{};
+    edit.set_user_data(uint32_t{1});
+    for(int x = 0; x < extent; x += 8){
+        for(int y = 0; y < extent/2; y += 8){
+            for(int z = 0; z < extent; z += 8){
+                typename svo_tree::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                tree.alloc(pos_, edit);
+            }
+        }
+    }
+
+    svo_bench.run("svo_get(N^3) edited", get_all);
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << " dense voxels";
+    strbuf << ", " << (built_size / 1000.0) << " KB built";
+    strbuf << ", " << (collapsed_size / 1000.0) << " KB collapsed";
+    strbuf << ", " << (tree.byte_size() / 1000.0) << " KB edited";
+    strbuf << "\033[0m" << "\n";
+
+    svo_report(strbuf, svo_bench, positions.size());
+}
+
+////////////////////////
+// neighbouring chunks of a layered heightmap terrain (rock bands under a dirt cover), each 
+// chunk frozen on its own against all of them merged into one shared dag
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_dag_bench(std::stringstream& strbuf, std::string name, int extent, int chunks, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    std::vector<std::unique_ptr<svo_tree>> trees{};
+    uint64_t voxel_count = 0;
+    for(int chunk = 0; chunk < chunks; ++chunk)
+    {
+        std::vector<typename svo_tree::spatial_voxel> voxels{};
+        for(int x = 0; x < extent; ++x){
+            for(int z = 0; z < extent; ++z){
+                const int world_x = chunk * extent + x;
+                const double wave = std::sin(world_x * 0.11) * std::cos(z * 0.07) + 1.0;
+                const int height = static_cast<int>(extent / 4 + wave * extent / 8);
+                for(int y = 0; y <= height; ++y){
+                    typename svo_tree::spatial_voxel voxel;
+                    typename svo_tree::vector_type pos_{
+                        (svo_component_type)x,
+                        (svo_component_type)y,
+                        (svo_component_type)z};
+                    voxel.encode_position(&pos_[0]); 
+                    voxel._data.set_user_data(static_cast<uint32_t>(y > height - 3 ? 2 : (y / 4) % 2));
+                    voxels.push_back(voxel);
+                }
+            }
+        }
+        voxel_count += voxels.size();
+        trees.push_back(std::make_unique<svo_tree>());
+        trees.back()->alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    }
+
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                positions.emplace_back(x,y,z);
+            }
+        }
+    }
+
+    uint64_t tree_size = 0;
+    uint64_t frozen_size = 0;
+    uint64_t dag_size = 0;
+    for(const auto& tree : trees) {
+        tree_size   += tree->byte_size();
+        frozen_size += tree->freeze().byte_size();
+        dag_size    += tree->to_dag().byte_size();
+    }
+
+    rapid_svo::dag_tree<svo_tree> shared{};
+    for(const auto& tree : trees) {
+        tree->to_dag(shared); }
+    const uint64_t shared_size = shared.byte_size();
+    shared.release_merge_tables();
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << chunks << " chunks, " << voxel_count << " voxels";
+    strbuf << ", " << (tree_size / 1000.0) << " KB trees";
+    strbuf << ", " << (frozen_size / 1000.0) << " KB frozen";
+    strbuf << ", " << (dag_size / 1000.0) << " KB dags";
+    strbuf << ", " << (shared_size / 1000.0) << " KB shared dag";
+    strbuf << ", " << (shared.byte_size() / 1000.0) << " KB without merge tables";
+    strbuf << "\033[0m" << "\n";
+
+    svo_bench.run("svo_to_dag(chunks) shared", [&] {
+        rapid_svo::dag_tree<svo_tree> dag{};
+        for(const auto& tree : trees) {
+            tree->to_dag(dag); }
+        doNotOptimizeAway(dag.get_node_count());
+    });
+
+    auto get_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    get_bench.output(nullptr);
+    get_bench.epochs(max_epochs);
+
+    const auto frozen = trees[0]->freeze();
+
+    get_bench.run("svo_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(trees[0]->get(position));
+        }
+    });
+
+    get_bench.run("svo_frozen_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(frozen.get(position));
+        }
+    });
+
+    get_bench.run("svo_dag_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(shared.get(position));
+        }
+    });
+
+    svo_report(strbuf, svo_bench, voxel_count);
+    svo_report(strbuf, get_bench, positions.size());
+}
+
+////////////////////////
+// 2^3 voxel blocks against 4^3 and 8^3 bricks, on the lower half of the cube filled solid 
+// and on the sparse surface
+////////////////////////
+template<typename SVO_TREE_T, typename SVO_BRICK4_T, typename SVO_BRICK8_T>
+static void svo_brick_bench(std::stringstream& strbuf, std::string name, int extent, bool dense, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    auto get_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    get_bench.output(nullptr);
+    get_bench.epochs(max_epochs);
+
+    std::vector<typename svo_tree::spatial_voxel> voxels{};
+    if(dense) {
+        for(int x = 0; x < extent; ++x){
+            for(int y = 0; y < extent/2; ++y){
+                for(int z = 0; z < extent; ++z){
+                    typename svo_tree::spatial_voxel voxel;
+                    typename svo_tree::vector_type pos_{
+                        (svo_component_type)x,
+                        (svo_component_type)y,
+                        (svo_component_type)z};
+                    voxel.encode_position(&pos_[0]); 
+                    voxels.push_back(voxel);
+                }
+            }
+        }
+    } else {
+        voxels = svo_surface_voxels<svo_tree>(extent);
+    }
+
+    std::vector<typename svo_tree::vector_type> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent; ++y){
+            for(int z = 0; z < extent; ++z){
+                positions.emplace_back(x,y,z);
+            }
+        }
+    }
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    SVO_BRICK4_T brick4_tree{};
+    brick4_tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    SVO_BRICK8_T brick8_tree{};
+    brick8_tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << voxels.size() << (dense ? " dense" : " surface") << " voxels";
+    strbuf << ", " << (tree.byte_size() / 1000.0) << " KB";
+    strbuf << ", 4^3 bricks " << (brick4_tree.byte_size() / 1000.0) << " KB";
+    strbuf << ", 8^3 bricks " << (brick8_tree.byte_size() / 1000.0) << " KB";
+    strbuf << "\033[0m" << "\n";
+
+    svo_bench.run("svo_alloc_bulk(voxels)", [&] {
+        svo_tree built{};
+        built.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    });
+
+    svo_bench.run("svo_brick4_alloc_bulk(voxels)", [&] {
+        SVO_BRICK4_T built{};
+        built.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    });
+
+    svo_bench.run("svo_brick8_alloc_bulk(voxels)", [&] {
+        SVO_BRICK8_T built{};
+        built.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    });
+
+    get_bench.run("svo_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(tree.get(position));
+        }
+    });
+
+    get_bench.run("svo_brick4_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(brick4_tree.get(position));
+        }
+    });
+
+    get_bench.run("svo_brick8_get(N^3)", [&] {
+        for(const auto& position : positions) {
+            doNotOptimizeAway(brick8_tree.get(position));
+        }
+    });
+
+    svo_report(strbuf, svo_bench, voxels.size());
+    svo_report(strbuf, get_bench, positions.size());
+}
+
+// grid stepping baseline, one tree::get per visited cell
+////////////////////////
+// every thread runs gets over the whole tree mixed with alloc / dealloc in its own top level 
+// octant, once on a plain tree behind a global mutex and once on a concurrent tree
+////////////////////////
+template<typename SVO_TREE_T, typename SVO_CONCURRENT_TREE_T>
+static void svo_concurrent_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_concurrent_tree = SVO_CONCURRENT_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    constexpr uint32_t OPS_PER_THREAD = 1 << 16;
+    constexpr uint32_t WRITE_EVERY = 16;
+
+    std::vector<typename svo_tree::spatial_voxel> voxels = svo_surface_voxels<svo_tree>(extent);
+    std::vector<typename svo_concurrent_tree::spatial_voxel> concurrent_voxels(voxels.size());
+    for(size_t i = 0; i < voxels.size(); ++i) {
+        concurrent_voxels[i]._morton = voxels[i]._morton; }
+
+    std::vector<typename svo_tree::vector_type> positions{};
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> axis_dist(0, extent - 1);
+    for(uint32_t i = 0; i < OPS_PER_THREAD; ++i) {
+        positions.push_back({
+            (svo_component_type)axis_dist(rng), 
+            (svo_component_type)axis_dist(rng), 
+            (svo_component_type)axis_dist(rng)});
+    }
+
+    svo_tree tree{};
+    tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+    svo_concurrent_tree concurrent_tree{};
+    concurrent_tree.alloc_bulk(concurrent_voxels.data(), static_cast<uint32_t>(concurrent_voxels.size()));
+    std::mutex tree_mutex{};
+
+    // thread t writes to octant t % 8, positions are folded into it
+    auto octant_position = [extent](typename svo_tree::vector_type pos_, uint32_t thread_) {
+        const int half_ = extent / 2;
+        for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+            pos_[axis_] = (svo_component_type)((pos_[axis_] % half_) + (((thread_ % 8) >> axis_) & 1u) * half_); }
+        return pos_;
+    };
+
+    auto run_threads = [](uint32_t threads_, auto&& fn_) {
+        std::vector<std::thread> pool_{};
+        for(uint32_t t = 1; t < threads_; ++t) {
+            pool_.emplace_back(fn_, t); }
+        fn_(0u);
+        for(auto& thread_ : pool_) {
+            thread_.join(); }
+    };
+
+    const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << OPS_PER_THREAD << " ops per thread, 1 write per " << WRITE_EVERY << ", " << hardware_threads << " hardware threads";
+    strbuf << "\033[0m" << "\n";
+
+    for(uint32_t threads = 1; ; threads = std::min(threads * 2, hardware_threads))
+    {
+        svo_bench.run("svo_mutex_get_alloc_dealloc x" + std::to_string(threads), [&] {
+            run_threads(threads, [&](uint32_t thread_) {
+                for(uint32_t i = 0; i < OPS_PER_THREAD; ++i) 
+                {
+                    std::lock_guard<std::mutex> lock_(tree_mutex);
+                    if(i % WRITE_EVERY == 0) {
+                        auto pos_ = octant_position(positions[i], thread_);
+                        if(!tree.dealloc(pos_)) {
+                            typename svo_tree::voxel_format voxel_{};
+                            tree.alloc(pos_, voxel_); }
+                    } else {
+                        ankerl::nanobench::doNotOptimizeAway(tree.get(positions[i])); 
+                    }
+                }
+            });
+        });
+
+        svo_bench.run("svo_concurrent_get_alloc_dealloc x" + std::to_string(threads), [&] {
+            run_threads(threads, [&](uint32_t thread_) {
+                for(uint32_t i = 0; i < OPS_PER_THREAD; ++i) 
+                {
+                    if(i % WRITE_EVERY == 0) {
+                        auto pos_ = octant_position(positions[i], thread_);
+                        if(!concurrent_tree.dealloc(pos_)) {
+                            typename svo_concurrent_tree::voxel_format voxel_{};
+                            concurrent_tree.alloc(pos_, voxel_); }
+                    } else {
+                        ankerl::nanobench::doNotOptimizeAway(concurrent_tree.get(positions[i])); 
+                    }
+                }
+            });
+            concurrent_tree.reclaim();
+        });
+
+        if(threads == hardware_threads) {
+            break; }
+    }
+
+    svo_report(strbuf, svo_bench, OPS_PER_THREAD, "op");
+}
+
+////////////////////////
+// surface of chunks x 1 x chunks trees, world-space gets in scanline order and shuffled, 
+// against a std::unordered_map of trees looked up on every access
+////////////////////////
+template<typename SVO_TREE_T>
+static void svo_world_bench(std::stringstream& strbuf, std::string name, int chunks, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_world = rapid_svo::world<svo_tree>;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+    svo_bench.output(nullptr);
+    svo_bench.epochs(max_epochs);
+
+    const int chunk_extent = svo_tree::BOUNDS[0];
+    const int extent = chunks * chunk_extent;
+
+    struct chunk_hash {
+        size_t operator()(const glm::ivec3& c) const {
+            return std::hash<int64_t>()((int64_t(c.x) * 73856093) ^ (int64_t(c.y) * 19349663) ^ (int64_t(c.z) * 83492791)); }
+    };
+    std::unordered_map<glm::ivec3, svo_tree, chunk_hash> chunk_map{};
+    svo_world world{};
+
+    // world positions centred on the origin so chunks with negative coordinates are used too
+    std::vector<glm::ivec3> positions{};
+    for(int x = 0; x < extent; ++x){
+        for(int z = 0; z < extent; ++z){
+            const double wave = std::sin(x * 0.11) * std::cos(z * 0.07) + 1.0;
+            const int height = static_cast<int>(chunk_extent / 4 + wave * chunk_extent / 8);
+            for(int y = height - 1; y <= height; ++y){
+                const glm::ivec3 pos_{x - extent / 2, y, z - extent / 2};
+                typename svo_tree::voxel_format voxel_{};
+                world.alloc(pos_, voxel_);
+                const glm::ivec3 chunk_ = svo_world::chunk_of(pos_);
+                typename svo_tree::vector_type local_(pos_ - svo_world::chunk_origin(chunk_));
+                chunk_map[chunk_].alloc(local_, voxel_);
+                positions.push_back(pos_);
+            }
+        }
+    }
+
+    std::vector<glm::ivec3> shuffled = positions;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+    strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+    strbuf << " \x1B[33m" << positions.size() << " voxels, " << world.get_chunk_count() << " chunks";
+    strbuf << "\033[0m" << "\n";
+
+    auto map_get = [&](const glm::ivec3& pos_) -> typename svo_tree::voxel_format* {
+        const glm::ivec3 chunk_ = svo_world::chunk_of(pos_);
+        auto it_ = chunk_map.find(chunk_);
+        if(it_ == chunk_map.end()) {
+            return nullptr; }
+        const glm::ivec3 local_ = pos_ - svo_world::chunk_origin(chunk_);
+        return it_->second.get(typename svo_tree::vector_type{
+            (svo_component_type)local_.x, (svo_component_type)local_.y, (svo_component_type)local_.z});
+    };
+
+    svo_bench.run("svo_unordered_map_get(voxels)", [&] {
+        for(const auto& pos_ : positions) {
+            doNotOptimizeAway(map_get(pos_)); }
+    });
+
+    svo_bench.run("svo_world_get(voxels)", [&] {
+        for(const auto& pos_ : positions) {
+            doNotOptimizeAway(world.get(pos_)); }
+    });
+
+    svo_bench.run("svo_unordered_map_get(shuffled voxels)", [&] {
+        for(const auto& pos_ : shuffled) {
+            doNotOptimizeAway(map_get(pos_)); }
+    });
+
+    svo_bench.run("svo_world_get(shuffled voxels)", [&] {
+        for(const auto& pos_ : shuffled) {
+            doNotOptimizeAway(world.get(pos_)); }
+    });
+
+    svo_report(strbuf, svo_bench, positions.size());
+}
+
+template<typename SVO_TREE_T>
+static typename SVO_TREE_T::voxel_format* svo_dda_get(SVO_TREE_T& tree, const rapid_svo::ray& ray)
+{
+    using svo_component_type = rapid_svo::morton_util<SVO_TREE_T::get_type()>::component_type;
+
+    const glm::vec3 dir = glm::normalize(ray._direction);
+    glm::ivec3 cell{(int)std::floor(ray._origin.x), (int)std::floor(ray._origin.y), (int)std::floor(ray._origin.z)};
+    glm::ivec3 step{};
+    glm::vec3 t_max{};
+    glm::vec3 t_delta{};
+    for(int axis = 0; axis < 3; ++axis){
+        step[axis] = dir[axis] < 0.0f ? -1 : 1;
+        t_delta[axis] = dir[axis] != 0.0f ? std::abs(1.0f / dir[axis]) : 1e30f;
+        const float boundary = static_cast<float>(cell[axis] + (step[axis] > 0 ? 1 : 0));
+        t_max[axis] = dir[axis] != 0.0f ? (boundary - ray._origin[axis]) / dir[axis] : 1e30f;
+    }
+
+    float t = 0.0f;
+    while(t <= ray._max_distance){
+        for(int axis = 0; axis < 3; ++axis){
+            if(cell[axis] < 0 || cell[axis] >= static_cast<int>(SVO_TREE_T::BOUNDS[axis])) {
+                return nullptr; }
+        }
+        typename SVO_TREE_T::vector_type pos_{
+            (svo_component_type)cell.x,
+            (svo_component_type)cell.y,
+            (svo_component_type)cell.z};
+        if(auto voxel = tree.get(pos_)) {
+            return voxel; }
+
+        const int axis = t_max.x < t_max.y ? (t_max.x < t_max.z ? 0 : 2) : (t_max.y < t_max.z ? 1 : 2);
+        t = t_max[axis];
+        t_max[axis] += t_delta[axis];
+        cell[axis] += step[axis];
+    }
+    return nullptr;
+}
+
+template<typename SVO_TREE_T>
+static void svo_raycast_bench(std::stringstream& strbuf, std::string name, int extent, int max_epochs = 11, int max_iters = 50)
+{
+    using namespace ankerl::nanobench;
+    using svo_tree = SVO_TREE_T;
+    using svo_component_type = rapid_svo::morton_util<svo_tree::get_type()>::component_type;
+
+    constexpr int ray_count = 1 << 14;
+
+    // rays start in the empty upper quarter and aim at random points of the lower half
+    std::vector<rapid_svo::ray> rays(ray_count);
+    std::mt19937 rng{ 1234 };
+    std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+    for(auto& ray : rays){
+        ray._origin = glm::vec3(unit(rng) * extent, (0.75f + unit(rng) * 0.25f) * extent, unit(rng) * extent);
+        const glm::vec3 target(unit(rng) * extent, unit(rng) * extent * 0.5f, unit(rng) * extent);
+        ray._direction = target - ray._origin;
+        ray._max_distance = static_cast<float>(extent) * 2.0f;
+    }
+
+    std::vector<typename svo_tree::spatial_voxel> dense_voxels{};
+    for(int x = 0; x < extent; ++x){
+        for(int y = 0; y < extent/2; ++y){
+            for(int z = 0; z < extent; ++z){
+                typename svo_tree::spatial_voxel voxel;
+                typename svo_tree::vector_type pos_{
+                    (svo_component_type)x,
+                    (svo_component_type)y,
+                    (svo_component_type)z};
+                voxel.encode_position(&pos_[0]); 
+                dense_voxels.push_back(voxel);
+            }
+        }
+    }
+
+    std::pair<const char*, std::vector<typename svo_tree::spatial_voxel>> scenes[] = {
+        { "dense", std::move(dense_voxels) },
+        { "sparse", svo_surface_voxels<svo_tree>(extent) }};
+
+    std::vector<typename svo_tree::raycast_hit> hits(ray_count);
+
+    for(auto& [scene_name, voxels] : scenes)
+    {
+        auto svo_bench = ankerl::nanobench::Bench().minEpochIterations(max_iters);
+        svo_bench.output(nullptr);
+        svo_bench.epochs(max_epochs);
+
+        svo_tree tree{};
+        tree.alloc_bulk(voxels.data(), static_cast<uint32_t>(voxels.size()));
+
+        strbuf << "\n[" << TERMINAL_ANSI_CYAN(name) << "]";
+        strbuf << " \x1B[33m" << scene_name << ", " << voxels.size() << " voxels";
+        strbuf << ", " << (tree.byte_size() / 1000.0) << " KB";
+        strbuf << "\033[0m" << "\n";
+
+        svo_bench.run("svo_dda_get(rays)", [&] {
+            for(const auto& ray : rays) {
+                doNotOptimizeAway(svo_dda_get(tree, ray));
+            }
+        });
+
+        svo_bench.run("svo_raycast(rays)", [&] {
+            for(const auto& ray : rays) {
+                doNotOptimizeAway(tree.raycast(ray._origin, ray._direction, ray._max_distance));
+            }
+        });
+
+        svo_bench.run("svo_raycast_bulk(rays)", [&] {
+            tree.raycast_bulk(rays.data(), hits.data(), hits.size());
+            doNotOptimizeAway(hits.data());
+        });
+
+        svo_report(strbuf, svo_bench, ray_count, "ray");
+    }
+}
+
+int main()
+{
+    using namespace ankerl::nanobench;
+    
+    printf("\nRAPID_SVO running benchmarks... this will take a moment\n");
+
+    std::stringstream
+    all_results{};
+
+    constexpr rapid_svo::details_info details_16b_16pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 16,16,16 }};
+
+    constexpr rapid_svo::details_info details_16b_32pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 32,32,32 }};
+
+    constexpr rapid_svo::details_info details_32b_32pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 32,32,32 }};
+           
+    constexpr rapid_svo::details_info details_32b_32x20x32{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 32,20,32 }};
+
+    constexpr rapid_svo::details_info details_32b_64pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 64,64,64 }};
+
+    constexpr rapid_svo::details_info details_32b_128pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 128,128,128 }};
+
+    constexpr rapid_svo::details_info details_32b_256pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 }};
+
+    constexpr rapid_svo::details_info details_32b_512pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 512,512,512 }};
+
+    constexpr rapid_svo::details_info details_32b_256pow3_concurrent{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 },
+        ._concurrent = true};
+
+    constexpr rapid_svo::details_info details_32b_256pow3_dirty{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 },
+        ._track_dirty = true};
+
+    constexpr rapid_svo::details_info details_32b_256pow3_aggregate{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 },
+        ._aggregate = true};
+
+    constexpr rapid_svo::details_info details_32b_256pow3_collapse{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 },
+        ._collapse_uniform = true};
+
+    constexpr rapid_svo::details_info details_32b_1024pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 1024,1024,1024 }};
+
+    constexpr rapid_svo::details_info details_64b_32pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 32,32,32 }};
+
+    constexpr rapid_svo::details_info details_64b_64pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 64,64,64 }};
+
+    constexpr rapid_svo::details_info details_64b_128pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 128,128,128 }};
+
+    constexpr rapid_svo::details_info details_64b_256pow3{
+        ._discard_overflow = true,
+        ._limit_max_bounds = { 256,256,256 }};
+
+    constexpr rapid_svo::details_info details_32b_64pow3_full_space{};
+
+    constexpr rapid_svo::details_info details_32b_128pow3_full_space{};
+
+    constexpr rapid_svo::details_info details_32b_256pow3_full_space{};
+
+    std::stringstream strbuf{};
+
+    //all_results << svo_bench<svo::tree<svo::morton_32b, svo::basic_voxel_format, details_32b_1024pow3>>
+    //("32b_space__svo_bench(128^3)__64bit_voxels", 128, 1,1);
+            
+    svo_bench<rapid_svo::tree<rapid_svo::morton_16b, rapid_svo::basic_voxel_format, details_16b_16pow3>>
+    (strbuf, "16b_space__svo_bench(16^3)__64bit_voxels", 16);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_16b, rapid_svo::basic_voxel_format, details_16b_32pow3>>
+    (strbuf, "16b_space__svo_bench(32^3)__64bit_voxels", 32);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_32pow3>>
+    (strbuf, "32b_space__svo_bench(32^3)__64bit_voxels", 32);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_bench(64^3)__64bit_voxels", 64, 6, 10);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3>>
+    (strbuf, "32b_space__svo_bench(128^3)__64bit_voxels", 128, 1, 1);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_64b, rapid_svo::basic_voxel_format, details_64b_32pow3>>
+    (strbuf, "64b_space__svo_bench(32^3)__64bit_voxels", 32);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_64b, rapid_svo::basic_voxel_format, details_64b_64pow3>>
+    (strbuf, "64b_space__svo_bench(64^3)__64bit_voxels", 64, 6, 10);
+
+    svo_bench<rapid_svo::tree<rapid_svo::morton_64b, rapid_svo::basic_voxel_format, details_64b_128pow3>>
+    (strbuf, "64b_space__svo_bench(128^3)__64bit_voxels", 128, 1, 1);
+
+    svo_sparse_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3>>
+    (strbuf, "32b_space__svo_sparse_bench(128^3)__64bit_voxels", 128, 1, 1);
+
+    svo_sparse_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_sparse_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_sparse_bench<rapid_svo::tree<rapid_svo::morton_64b, rapid_svo::basic_voxel_format, details_64b_256pow3>>
+    (strbuf, "64b_space__svo_sparse_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_neighborhood_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_neighborhood_bench(64^3)__64bit_voxels", 64, 6, 10);
+
+    svo_neighborhood_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_neighborhood_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_parallel_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_parallel_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_parallel_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_512pow3>>
+    (strbuf, "32b_space__svo_parallel_bench(512^3)__64bit_voxels", 512, 1, 1);
+
+    svo_world_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_world_bench(16x1x16 chunks of 64^3)__64bit_voxels", 16, 1, 1);
+
+    svo_snapshot_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_snapshot_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_brick_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3>,
+        rapid_svo::brick_tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3, 2>,
+        rapid_svo::brick_tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_128pow3, 3>>
+    (strbuf, "32b_space__svo_brick_bench(128^3)__64bit_voxels", 128, true, 1, 1);
+
+    svo_brick_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>,
+        rapid_svo::brick_tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3, 2>,
+        rapid_svo::brick_tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3, 3>>
+    (strbuf, "32b_space__svo_brick_bench(256^3)__64bit_voxels", 256, false, 1, 1);
+
+    svo_morton_bench<rapid_svo::morton_32b>
+    (strbuf, "32b_space__svo_morton_bench(1M)", 1 << 20, 3, 10);
+
+    svo_morton_bench<rapid_svo::morton_64b>
+    (strbuf, "64b_space__svo_morton_bench(1M)", 1 << 20, 3, 10);
+
+    svo_lod_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>,
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3_aggregate>>
+    (strbuf, "32b_space__svo_lod_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_stamp_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_stamp_bench(256^3, r=64)__64bit_voxels", 64.0f, 1, 1);
+
+    svo_csg_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_csg_bench(256^3, 64^3 prefab)__64bit_voxels", 256, 64, 1, 1);
+
+    svo_components_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>,
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_32x20x32>>
+    (strbuf, "32b_space__svo_components_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_dag_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_dag_bench(8x64^3)__64bit_voxels", 64, 8, 1, 1);
+
+    svo_collapse_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3_collapse>>
+    (strbuf, "32b_space__svo_collapse_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_churn_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_1024pow3>>
+    (strbuf, "32b_space__svo_churn_bench(1024^3)__64bit_voxels", 1024, 4, 1, 1);
+
+    svo_dirty_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>,
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3_dirty>>
+    (strbuf, "32b_space__svo_dirty_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_concurrent_bench<
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>,
+        rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3_concurrent>>
+    (strbuf, "32b_space__svo_concurrent_bench(256^3)__64bit_voxels", 256, 1, 1);
+
+    svo_overlap_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_overlap_bench(64^3)__64bit_voxels", 64, 6, 10);
+
+    svo_raycast_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_64pow3>>
+    (strbuf, "32b_space__svo_raycast_bench(64^3)__64bit_voxels", 64, 6, 10);
+
+    svo_raycast_bench<rapid_svo::tree<rapid_svo::morton_32b, rapid_svo::basic_voxel_format, details_32b_256pow3>>
+    (strbuf, "32b_space__svo_raycast_bench(256^3)__64bit_voxels", 256, 1, 1);
             
     std::cout << strbuf.str() << std::flush;
 
@@ -30,50 +30,111 @@
 
 #include <cstdint>
 #include <array>
-#include <queue>
+#include <vector>
+#include <bit>
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <concepts>
 
 #include "libmorton/morton3D.h"
 #include "glm/glm.hpp"
 
-#if defined(__clang__) || defined(__GNUC__)
+#if defined(__clang__)
     #define LOOP_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+    #define LOOP_UNROLL _Pragma("GCC unroll 32")
 #elif defined(_MSC_VER) && !defined(__clang__)
     #define LOOP_UNROLL __pragma(loop(unroll))
 #else
     #define LOOP_UNROLL
 #endif
 
+////////////////////////
+// tree_view maps snapshots with mmap, on Windows only when SVO_WIN32_FILE_MAPPING is defined 
+// before this header as that pulls in <windows.h>, otherwise the snapshot is read into memory
+////////////////////////
+#if defined(_WIN32)
+    #if defined(SVO_WIN32_FILE_MAPPING)
+        #ifndef NOMINMAX
+            #define NOMINMAX
+        #endif
+        #ifndef WIN32_LEAN_AND_MEAN
+            #define WIN32_LEAN_AND_MEAN
+        #endif
+        #include <windows.h>
+    #endif
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+////////////////////////
+// x86-64 kernels are compiled for their instruction set per function and only run after the CPU 
+// reported it, the header itself needs no -mbmi2 / -mavx2
+////////////////////////
+#if defined(__x86_64__) || defined(_M_X64)
+    #define SVO_X86_64 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define SVO_TARGET(isa_)
+    #else
+        #include <cpuid.h>
+        #define SVO_TARGET(isa_) __attribute__((target(isa_)))
+    #endif
+#else
+    #define SVO_X86_64 0
+#endif
+
+#if defined(__clang__) || defined(__GNUC__)
+    #define SVO_PREFETCH(addr) __builtin_prefetch(static_cast<const void*>(addr), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+    #define SVO_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+    #define SVO_PREFETCH(addr)
+#endif
+
 namespace rapid_svo
 {
     /////////////////////////////
     // (1) 
-    // to reduce complexity we want to only work in unsigned even integer space
+    // traversal walks directly on the morton code, 3 bits per level, so the child index of a
+    // level is a shift and a mask away and no vector math is needed on the hot path
     //
     // (2) 
-    // just row major ordering node index
+    // child index follows morton ordering (x bit 0, y bit 1, z bit 2), so the child 
+    // index at each level is the matching 3-bit group of the voxel morton code
     //
     // (3) 
     // not a fan of using this kind of multi-line macros but its absolutely necessary
     // for code readibility, tolerance for any extra overhead is zero and we also dont
     // want to rely on compiler inlining as its never 100% guaranteed 
 
-    #define SVO_NODE_RELATION_MATH_IMPL()\
-        auto node_transformed = node_position;\
-        node_transformed <<= 1;\
-        const auto dist_vector = voxel_transformed - node_transformed;\
-        const auto cell_vector = dist_vector / node_extent;\
-        auto index = (cell_vector[0] << 2) + (cell_vector[1] << 1) + cell_vector[2];\
-        auto next_node_position = node_position + (cell_vector * (component_type)(node_extent) / (component_type)2);\
-        const uint8_t child_bit = (1 << index);\
-        const auto exist = (node_->_mask & child_bit) != 0;
+    #define SVO_NODE_MORTON_CHILD_IMPL(depth_)\
+        const uint32_t index = static_cast<uint32_t>(voxel_morton >> (3 * (MAX_DEPTH - 1 - (depth_)))) & 7u;\
+        const uint8_t child_bit = static_cast<uint8_t>(1u << index);\
+        [[maybe_unused]] const bool exist = (load_mask(*node_) & child_bit) != 0;
         
     ///////////////////////////////
 
     enum bit_width
     {
         morton_16b,
-        morton_32b
+        morton_32b,
+        morton_64b
     };
 
     namespace util 
@@ -136,29 +197,676 @@ namespace rapid_svo
         requires (std::is_integral_v<T>) {
             return (size_ + min_align_ - 1) & ~(min_align_ - 1);
         }
+
+        ////////////////////////
+        // table popcount for child masks, std::popcount falls back to a library call 
+        // when the target has no popcnt instruction enabled
+        ////////////////////////
+        inline constexpr std::array<uint8_t, 256> POPCOUNT_8 = [] {
+            std::array<uint8_t, 256> table_{};
+            for(uint32_t i = 0; i < 256; ++i) {
+                table_[i] = static_cast<uint8_t>(std::popcount(i)); }
+            return table_;
+        }();
+
+        inline static uint32_t popcount8(uint8_t mask_) {
+            return POPCOUNT_8[mask_];
+        }
+
+        ////////////////////////
+        // face connected components of the voxels of a 2x2x2 block for every child mask, labels are 
+        // numbered from 0 in the order of their lowest octant, 0xFF for empty octants
+        ////////////////////////
+        struct block_components
+        {
+            std::array<std::array<uint8_t, 8>, 256> 
+            _labels{};
+
+            std::array<uint8_t, 256> 
+            _counts{};
+        };
+
+        inline constexpr block_components BLOCK_COMPONENTS = [] {
+            block_components table_{};
+            for(uint32_t mask_ = 0; mask_ < 256; ++mask_)
+            {
+                auto& labels_ = table_._labels[mask_];
+                labels_.fill(0xFF);
+                uint8_t count_ = 0;
+                for(uint32_t first_ = 0; first_ < 8; ++first_)
+                {
+                    if(((mask_ >> first_) & 1u) == 0 || labels_[first_] != 0xFF) {
+                        continue; }
+
+                    // face neighbours inside the block differ in one octant bit
+                    std::array<uint32_t, 8> stack_{first_};
+                    uint32_t size_ = 1;
+                    labels_[first_] = count_;
+                    while(size_ > 0)
+                    {
+                        const uint32_t octant_ = stack_[--size_];
+                        for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                            const uint32_t next_ = octant_ ^ (1u << axis_);
+                            if(((mask_ >> next_) & 1u) && labels_[next_] == 0xFF) {
+                                labels_[next_] = count_;
+                                stack_[size_++] = next_; } }
+                    }
+                    ++count_;
+                }
+                table_._counts[mask_] = count_;
+            }
+            return table_;
+        }();
+
+        // FNV-1a over size_ bytes, seed_ chains several calls into one hash
+        inline static uint64_t hash_bytes(const void* data_, size_t size_, uint64_t seed_ = 0xCBF29CE484222325ull)
+        {
+            const auto* bytes_ = static_cast<const uint8_t*>(data_);
+            for(size_t i = 0; i < size_; ++i) {
+                seed_ = (seed_ ^ bytes_[i]) * 0x100000001B3ull; }
+            return seed_;
+        }
+
+        ////////////////////////
+        // runs fn_(task) for every task in [0, tasks_) on up to threads_ threads, the calling thread 
+        // included, tasks are handed out one at a time so uneven tasks balance out
+        ////////////////////////
+        template<typename FN_T>
+        inline static void parallel_for(uint32_t tasks_, uint32_t threads_, FN_T&& fn_)
+        {
+            std::atomic<uint32_t> next_{0};
+            auto worker_ = [&]() {
+                for(uint32_t task_ = next_.fetch_add(1, std::memory_order_relaxed); task_ < tasks_; 
+                    task_ = next_.fetch_add(1, std::memory_order_relaxed)) {
+                    fn_(task_); }
+            };
+
+            std::vector<std::thread> threads_pool_{};
+            const uint32_t spawn_ = min(threads_, tasks_);
+            for(uint32_t i = 1; i < spawn_; ++i) {
+                threads_pool_.emplace_back(worker_); }
+            worker_();
+            for(auto& thread_ : threads_pool_) {
+                thread_.join(); }
+        }
+
+        ////////////////////////
+        // CPU features asked once at runtime, AVX2 also needs the OS to save the ymm registers, 
+        // AMD before family 19h (Zen 3) runs pdep / pext in microcode, slower than the tables
+        ////////////////////////
+        struct cpu_features
+        {
+            bool 
+            _bmi2{};
+
+            bool 
+            _slow_bmi2{};
+
+            bool 
+            _avx2{};
+        };
+
+        // family from cpuid leaf 1 eax, the extended family only counts when the base one is 0xF
+        inline static constexpr uint32_t cpu_family(uint32_t eax_)
+        {
+            const uint32_t base_ = (eax_ >> 8) & 0xF;
+            return base_ == 0xF ? base_ + ((eax_ >> 20) & 0xFF) : base_;
+        }
+
+        inline static cpu_features detect_cpu_features()
+        {
+            cpu_features features_{};
+        #if SVO_X86_64 && defined(_MSC_VER) && !defined(__clang__)
+            int regs_[4]{};
+            __cpuid(regs_, 0);
+            if(regs_[0] < 7) {
+                return features_; }
+            // "AuthenticAMD" split over ebx, edx, ecx
+            const bool amd_ = regs_[1] == 0x68747541 && regs_[3] == 0x69746E65 && regs_[2] == 0x444D4163;
+            __cpuid(regs_, 1);
+            const bool os_ymm_ = (regs_[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+            const uint32_t family_ = cpu_family(static_cast<uint32_t>(regs_[0]));
+            __cpuidex(regs_, 7, 0);
+            features_._bmi2 = (regs_[1] & (1 << 8)) != 0;
+            features_._avx2 = os_ymm_ && (regs_[1] & (1 << 5)) != 0;
+            features_._slow_bmi2 = features_._bmi2 && amd_ && family_ < 0x19;
+        #elif SVO_X86_64
+            __builtin_cpu_init();
+            features_._bmi2 = __builtin_cpu_supports("bmi2");
+            features_._avx2 = __builtin_cpu_supports("avx2");
+            unsigned int eax_{}, ebx_{}, ecx_{}, edx_{};
+            if(features_._bmi2 && __builtin_cpu_is("amd") && __get_cpuid(1, &eax_, &ebx_, &ecx_, &edx_)) {
+                features_._slow_bmi2 = cpu_family(eax_) < 0x19; }
+        #endif
+            return features_;
+        }
+
+        inline const cpu_features CPU_FEATURES = detect_cpu_features();
+
+        // rounds towards negative infinity, a shift for power of two divisors
+        inline static constexpr int32_t floor_div(int32_t value_, int32_t divisor_)
+        {
+            if(std::has_single_bit(static_cast<uint32_t>(divisor_))) {
+                return value_ >> std::countr_zero(static_cast<uint32_t>(divisor_)); }
+            const int32_t quotient_ = value_ / divisor_;
+            return quotient_ - static_cast<int32_t>((value_ % divisor_ != 0) & (value_ < 0));
+        }
+
+        template<typename T>
+        inline static constexpr T align_up(T value_, T alignment_)
+        {
+            return (value_ + alignment_ - 1) / alignment_ * alignment_;
+        }
+
+        ////////////////////////
+        // read-only memory mapping of a whole file, pages are faulted in on first touch, a copy 
+        // in 64 byte aligned memory on Windows without SVO_WIN32_FILE_MAPPING
+        ////////////////////////
+        struct mapped_file
+        {
+            mapped_file() = default;
+            mapped_file(const mapped_file&) = delete;
+            mapped_file& operator=(const mapped_file&) = delete;
+
+            mapped_file(mapped_file&& other_) noexcept { swap(other_); }
+
+            mapped_file& operator=(mapped_file&& other_) noexcept 
+            {
+                if(this != &other_) {
+                    close();
+                    swap(other_);
+                }
+                return *this;
+            }
+
+            ~mapped_file() { close(); }
+
+            bool open(const char* path_)
+            {
+                close();
+            #if defined(_WIN32) && defined(SVO_WIN32_FILE_MAPPING)
+                _file = CreateFileA(path_, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if(_file == INVALID_HANDLE_VALUE) {
+                    _file = nullptr;
+                    return false; }
+
+                LARGE_INTEGER size_{};
+                if(!GetFileSizeEx(_file, &size_) || size_.QuadPart <= 0) {
+                    close();
+                    return false; }
+
+                _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                const void* data_ = _mapping ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                if(data_ == nullptr) {
+                    close();
+                    return false; }
+
+                _data = static_cast<const uint8_t*>(data_);
+                _size = static_cast<size_t>(size_.QuadPart);
+            #elif defined(_WIN32)
+                std::FILE* file_ = std::fopen(path_, "rb");
+                if(file_ == nullptr) {
+                    return false; }
+
+                const int64_t size_ = _fseeki64(file_, 0, SEEK_END) == 0 ? _ftelli64(file_) : -1;
+                if(size_ <= 0 || _fseeki64(file_, 0, SEEK_SET) != 0) {
+                    std::fclose(file_);
+                    return false; }
+
+                // aligned like a mapping so the regions can be read in place
+                auto* data_ = static_cast<uint8_t*>(::operator new(static_cast<size_t>(size_), std::align_val_t{64}));
+                const bool read_ = std::fread(data_, 1, static_cast<size_t>(size_), file_) == static_cast<size_t>(size_);
+                std::fclose(file_);
+                _data = data_;
+                _size = static_cast<size_t>(size_);
+                if(!read_) {
+                    close();
+                    return false; }
+            #else
+                const int fd_ = ::open(path_, O_RDONLY);
+                if(fd_ < 0) {
+                    return false; }
+
+                struct stat stat_{};
+                if(fstat(fd_, &stat_) != 0 || stat_.st_size <= 0) {
+                    ::close(fd_);
+                    return false; }
+
+                void* data_ = mmap(nullptr, static_cast<size_t>(stat_.st_size), PROT_READ, MAP_SHARED, fd_, 0);
+                // the mapping keeps the file alive on its own
+                ::close(fd_);
+                if(data_ == MAP_FAILED) {
+                    return false; }
+
+                _data = static_cast<const uint8_t*>(data_);
+                _size = static_cast<size_t>(stat_.st_size);
+            #endif
+                return true;
+            }
+
+            void close()
+            {
+            #if defined(_WIN32) && defined(SVO_WIN32_FILE_MAPPING)
+                if(_data) { UnmapViewOfFile(_data); }
+                if(_mapping) { CloseHandle(_mapping); }
+                if(_file) { CloseHandle(_file); }
+                _mapping = nullptr;
+                _file = nullptr;
+            #elif defined(_WIN32)
+                if(_data) { ::operator delete(const_cast<uint8_t*>(_data), std::align_val_t{64}); }
+            #else
+                if(_data) { munmap(const_cast<uint8_t*>(_data), _size); }
+            #endif
+                _data = nullptr;
+                _size = 0;
+            }
+
+            [[nodiscard]] 
+            const uint8_t* data() const { return _data; }
+
+            [[nodiscard]] 
+            size_t size() const { return _size; }
+
+        private:
+
+            void swap(mapped_file& other_) 
+            {
+                std::swap(_data, other_._data);
+                std::swap(_size, other_._size);
+            #if defined(_WIN32) && defined(SVO_WIN32_FILE_MAPPING)
+                std::swap(_file, other_._file);
+                std::swap(_mapping, other_._mapping);
+            #endif
+            }
+
+            const uint8_t* 
+            _data{};
+
+            size_t 
+            _size{};
+
+        #if defined(_WIN32) && defined(SVO_WIN32_FILE_MAPPING)
+            HANDLE 
+            _file{};
+
+            HANDLE 
+            _mapping{};
+        #endif
+        };
+
+        template<typename KEY_T>
+        struct sort_entry
+        {
+            KEY_T 
+            _key{};
+
+            uint32_t 
+            _index{};
+        };
+
+        ////////////////////////
+        // stable LSD radix sort on key bits [key_shift_, key_shift_ + key_bits_), digits up to 
+        // MAX_DIGIT_BITS spread evenly over the range, all digit histograms are gathered in a 
+        // single pass and passes where every key shares the same digit are skipped
+        ////////////////////////
+        template<typename KEY_T>
+        inline static void radix_sort(std::vector<sort_entry<KEY_T>>& entries_, uint32_t key_bits_, uint32_t key_shift_ = 0)
+        requires (std::is_integral_v<KEY_T> && std::is_unsigned_v<KEY_T>) {
+            constexpr uint32_t MAX_DIGIT_BITS = 9;
+            const size_t count_ = entries_.size();
+            if(count_ == 0 || key_bits_ == 0) { 
+                return; }
+
+            const uint32_t passes_ = (key_bits_ + MAX_DIGIT_BITS - 1) / MAX_DIGIT_BITS;
+            const uint32_t digit_bits_ = (key_bits_ + passes_ - 1) / passes_;
+            const uint32_t buckets_ = 1u << digit_bits_;
+            const auto digit_mask_ = static_cast<KEY_T>(buckets_ - 1);
+
+            std::vector<uint32_t> histograms_(static_cast<size_t>(passes_) * buckets_, 0);
+            for(size_t i = 0; i < count_; ++i) {
+                for(uint32_t p = 0; p < passes_; ++p) {
+                    ++histograms_[p * buckets_ + ((entries_[i]._key >> (key_shift_ + p * digit_bits_)) & digit_mask_)];
+                }
+            }
+
+            std::vector<sort_entry<KEY_T>> swap_{};
+            for(uint32_t p = 0; p < passes_; ++p) 
+            {
+                uint32_t* histogram_ = &histograms_[p * buckets_];
+                const uint32_t shift_ = key_shift_ + p * digit_bits_;
+
+                if(histogram_[(entries_[0]._key >> shift_) & digit_mask_] == count_) { 
+                    continue; }
+
+                uint32_t offset_ = 0;
+                for(uint32_t b = 0; b < buckets_; ++b) {
+                    const uint32_t bucket_count_ = histogram_[b];
+                    histogram_[b] = offset_;
+                    offset_ += bucket_count_;
+                }
+
+                swap_.resize(count_);
+                for(size_t i = 0; i < count_; ++i) {
+                    swap_[histogram_[(entries_[i]._key >> shift_) & digit_mask_]++] = entries_[i];
+                }
+                entries_.swap(swap_);
+            }
+        }
     }
 
     
+    ////////////////////////
+    // morton_util::encode_n / decode_n implementations, table lookups run everywhere, bmi2 deposits 
+    // and extracts the axis bits directly, avx2 spreads 8 (4 with 64b) codes at once with shifts 
+    // and masks
+    ////////////////////////
+    enum morton_kernel
+    {
+        morton_kernel_lut,
+        morton_kernel_bmi2,
+        morton_kernel_avx2
+    };
+
     template<bit_width BIT_WIDTH>
     struct morton_util
     {
-        inline static constexpr uint32_t AXIS_MAX = BIT_WIDTH == morton_16b ? 32 : 1024;
-
-        using morton_type = std::conditional_t<BIT_WIDTH == morton_16b, uint16_t, uint32_t>;
+        inline static constexpr uint32_t AXIS_MAX = 
+            BIT_WIDTH == morton_16b ? 32 : 
+            BIT_WIDTH == morton_32b ? 1024 : 
+            2097152;
+
+        using morton_type = 
+            std::conditional_t<BIT_WIDTH == morton_16b, uint16_t, 
+            std::conditional_t<BIT_WIDTH == morton_32b, uint32_t, uint64_t>>;
         
-        using component_type   = std::conditional_t<BIT_WIDTH == morton_16b, uint8_t, uint16_t>;
+        using component_type = 
+            std::conditional_t<BIT_WIDTH == morton_16b, uint8_t, 
+            std::conditional_t<BIT_WIDTH == morton_32b, uint16_t, uint32_t>>;
         
-        using signed_component_type = std::conditional_t<BIT_WIDTH == morton_16b, int8_t, int16_t>;
+        using signed_component_type = 
+            std::conditional_t<BIT_WIDTH == morton_16b, int8_t, 
+            std::conditional_t<BIT_WIDTH == morton_32b, int16_t, int32_t>>;
+
+        inline static constexpr uint32_t AXIS_BITS = util::log2(AXIS_MAX);
+
+        // spreads component bits to every third bit, x axis placement (bit 0)
+        inline static constexpr morton_type dilate(uint32_t value_) {
+            morton_type res_ = 0;
+            for(uint32_t i = 0; i < AXIS_BITS; ++i) {
+                res_ |= static_cast<morton_type>(static_cast<morton_type>((value_ >> i) & 1u) << (i * 3)); }
+            return res_;
+        }
+
+        inline static constexpr morton_type AXIS_MASK = dilate(AXIS_MAX - 1);
 
         inline static void pos_to_morton(morton_type& morton, const component_type* in_) {
-            morton = libmorton::m3D_e_sLUT<morton_type>(in_[0],in_[1],in_[2]);
+            if constexpr (BIT_WIDTH == morton_64b) {
+                morton = split_by_3(in_[0]) | split_by_3(in_[1]) << 1 | split_by_3(in_[2]) << 2;
+            } else {
+                morton = libmorton::m3D_e_sLUT<morton_type>(in_[0],in_[1],in_[2]);
+            }
         }
 
         inline static void morton_to_pos(morton_type morton, component_type* out_) {
-            libmorton::m3D_d_sLUT<morton_type>(morton, out_[0],out_[1],out_[2]);
+            if constexpr (BIT_WIDTH == morton_64b) {
+                out_[0] = compact_by_3(morton);
+                out_[1] = compact_by_3(morton >> 1);
+                out_[2] = compact_by_3(morton >> 2);
+            } else {
+                libmorton::m3D_d_sLUT<morton_type>(morton, out_[0],out_[1],out_[2]);
+            }
+        }
+
+        ////////////////////////
+        // 64b axes are 21 bits wide, the byte LUT coders would walk every byte of the 32 bit 
+        // components and 7 chunks of the code, shift-and-mask spreading stays branchless and 
+        // the three axes run independently
+        ////////////////////////
+        inline static constexpr uint64_t split_by_3(uint64_t value_) {
+            value_ &= 0x1FFFFF;
+            value_ = (value_ | value_ << 32) & 0x001F00000000FFFF;
+            value_ = (value_ | value_ << 16) & 0x001F0000FF0000FF;
+            value_ = (value_ | value_ << 8)  & 0x100F00F00F00F00F;
+            value_ = (value_ | value_ << 4)  & 0x10C30C30C30C30C3;
+            value_ = (value_ | value_ << 2)  & 0x1249249249249249;
+            return value_;
+        }
+
+        inline static constexpr uint32_t compact_by_3(uint64_t value_) {
+            value_ &= 0x1249249249249249;
+            value_ = (value_ ^ (value_ >> 2))  & 0x10C30C30C30C30C3;
+            value_ = (value_ ^ (value_ >> 4))  & 0x100F00F00F00F00F;
+            value_ = (value_ ^ (value_ >> 8))  & 0x001F0000FF0000FF;
+            value_ = (value_ ^ (value_ >> 16)) & 0x001F00000000FFFF;
+            value_ = (value_ ^ (value_ >> 32)) & 0x00000000001FFFFF;
+            return static_cast<uint32_t>(value_);
+        }
+
+        [[nodiscard]] 
+        static bool kernel_supported(morton_kernel kernel_)
+        {
+            switch(kernel_) {
+                case morton_kernel_bmi2: return util::CPU_FEATURES._bmi2;
+                case morton_kernel_avx2: return util::CPU_FEATURES._avx2;
+                default: return true;
+            }
+        }
+
+        ////////////////////////
+        // bmi2 where the CPU runs it natively, it moves every bit of a code in one instruction per 
+        // axis, then avx2, then the tables, so AMD before Zen 3 gets avx2 (or the tables) while 
+        // morton_kernel_bmi2 can still be passed to encode_n / decode_n explicitly
+        ////////////////////////
+        [[nodiscard]] 
+        static morton_kernel best_kernel()
+        {
+            return 
+                util::CPU_FEATURES._bmi2 && !util::CPU_FEATURES._slow_bmi2 ? morton_kernel_bmi2 : 
+                util::CPU_FEATURES._avx2 ? morton_kernel_avx2 : 
+                morton_kernel_lut;
+        }
+
+        ////////////////////////
+        // count positions as x, y, z component triples (an array of vector_type) into count codes, 
+        // an unsupported kernel falls back to the tables
+        ////////////////////////
+        static void encode_n(const component_type* positions_, morton_type* out_, size_t count_, morton_kernel kernel_ = best_kernel())
+        {
+            size_t done_ = 0;
+        #if SVO_X86_64
+            if(kernel_ == morton_kernel_bmi2 && util::CPU_FEATURES._bmi2) {
+                done_ = encode_bmi2(positions_, out_, count_); }
+            else if(kernel_ == morton_kernel_avx2 && util::CPU_FEATURES._avx2) {
+                done_ = encode_avx2(positions_, out_, count_); }
+        #endif
+            for(size_t i = done_; i < count_; ++i) {
+                pos_to_morton(out_[i], positions_ + i * 3); }
+        }
+
+        // count codes into count x, y, z component triples
+        static void decode_n(const morton_type* mortons_, component_type* out_, size_t count_, morton_kernel kernel_ = best_kernel())
+        {
+            size_t done_ = 0;
+        #if SVO_X86_64
+            if(kernel_ == morton_kernel_bmi2 && util::CPU_FEATURES._bmi2) {
+                done_ = decode_bmi2(mortons_, out_, count_); }
+            else if(kernel_ == morton_kernel_avx2 && util::CPU_FEATURES._avx2) {
+                done_ = decode_avx2(mortons_, out_, count_); }
+        #endif
+            for(size_t i = done_; i < count_; ++i) {
+                morton_to_pos(mortons_[i], out_ + i * 3); }
         }
 
         morton_util() = delete;
+
+    private:
+
+    #if SVO_X86_64
+        // the kernels return how many entries they handled, the caller finishes the rest
+        SVO_TARGET("bmi2")
+        static size_t encode_bmi2(const component_type* positions_, morton_type* out_, size_t count_)
+        {
+            for(size_t i = 0; i < count_; ++i) 
+            {
+                const component_type* in_ = positions_ + i * 3;
+                if constexpr (BIT_WIDTH == morton_64b) {
+                    out_[i] = _pdep_u64(in_[0], AXIS_MASK) | _pdep_u64(in_[1], AXIS_MASK << 1) | _pdep_u64(in_[2], AXIS_MASK << 2);
+                } else {
+                    out_[i] = static_cast<morton_type>(_pdep_u32(in_[0], AXIS_MASK) | _pdep_u32(in_[1], AXIS_MASK << 1) | _pdep_u32(in_[2], AXIS_MASK << 2));
+                }
+            }
+            return count_;
+        }
+
+        SVO_TARGET("bmi2")
+        static size_t decode_bmi2(const morton_type* mortons_, component_type* out_, size_t count_)
+        {
+            for(size_t i = 0; i < count_; ++i) 
+            {
+                component_type* pos_ = out_ + i * 3;
+                if constexpr (BIT_WIDTH == morton_64b) {
+                    pos_[0] = static_cast<component_type>(_pext_u64(mortons_[i], AXIS_MASK));
+                    pos_[1] = static_cast<component_type>(_pext_u64(mortons_[i], AXIS_MASK << 1));
+                    pos_[2] = static_cast<component_type>(_pext_u64(mortons_[i], AXIS_MASK << 2));
+                } else {
+                    pos_[0] = static_cast<component_type>(_pext_u32(mortons_[i], AXIS_MASK));
+                    pos_[1] = static_cast<component_type>(_pext_u32(mortons_[i], AXIS_MASK << 1));
+                    pos_[2] = static_cast<component_type>(_pext_u32(mortons_[i], AXIS_MASK << 2));
+                }
+            }
+            return count_;
+        }
+
+        // 16b / 32b codes in 32 bit lanes, 10 bit components at most
+        SVO_TARGET("avx2")
+        static __m256i split_by_3_x8(__m256i value_)
+        {
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi32(value_, 16)), _mm256_set1_epi32(0x030000FF));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi32(value_, 8)),  _mm256_set1_epi32(0x0300F00F));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi32(value_, 4)),  _mm256_set1_epi32(0x030C30C3));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi32(value_, 2)),  _mm256_set1_epi32(0x09249249));
+            return value_;
+        }
+
+        SVO_TARGET("avx2")
+        static __m256i compact_by_3_x8(__m256i value_)
+        {
+            value_ = _mm256_and_si256(value_, _mm256_set1_epi32(0x09249249));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi32(value_, 2)),  _mm256_set1_epi32(0x030C30C3));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi32(value_, 4)),  _mm256_set1_epi32(0x0300F00F));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi32(value_, 8)),  _mm256_set1_epi32(0x030000FF));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi32(value_, 16)), _mm256_set1_epi32(0x000003FF));
+            return value_;
+        }
+
+        // 64b codes in 64 bit lanes, the same steps as split_by_3 / compact_by_3
+        SVO_TARGET("avx2")
+        static __m256i split_by_3_x4(__m256i value_)
+        {
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi64(value_, 32)), _mm256_set1_epi64x(0x001F00000000FFFF));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi64(value_, 16)), _mm256_set1_epi64x(0x001F0000FF0000FF));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi64(value_, 8)),  _mm256_set1_epi64x(0x100F00F00F00F00F));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi64(value_, 4)),  _mm256_set1_epi64x(0x10C30C30C30C30C3));
+            value_ = _mm256_and_si256(_mm256_or_si256(value_, _mm256_slli_epi64(value_, 2)),  _mm256_set1_epi64x(0x1249249249249249));
+            return value_;
+        }
+
+        SVO_TARGET("avx2")
+        static __m256i compact_by_3_x4(__m256i value_)
+        {
+            value_ = _mm256_and_si256(value_, _mm256_set1_epi64x(0x1249249249249249));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi64(value_, 2)),  _mm256_set1_epi64x(0x10C30C30C30C30C3));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi64(value_, 4)),  _mm256_set1_epi64x(0x100F00F00F00F00F));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi64(value_, 8)),  _mm256_set1_epi64x(0x001F0000FF0000FF));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi64(value_, 16)), _mm256_set1_epi64x(0x001F00000000FFFF));
+            value_ = _mm256_and_si256(_mm256_xor_si256(value_, _mm256_srli_epi64(value_, 32)), _mm256_set1_epi64x(0x00000000001FFFFF));
+            return value_;
+        }
+
+        SVO_TARGET("avx2")
+        static size_t encode_avx2(const component_type* positions_, morton_type* out_, size_t count_)
+        {
+            if constexpr (BIT_WIDTH == morton_64b) 
+            {
+                const __m128i offsets_ = _mm_setr_epi32(0, 3, 6, 9);
+                const auto* base_ = reinterpret_cast<const int*>(positions_);
+                size_t i = 0;
+                for(; i + 4 <= count_; i += 4) 
+                {
+                    const int* group_ = base_ + i * 3;
+                    const __m256i x_ = split_by_3_x4(_mm256_cvtepu32_epi64(_mm_i32gather_epi32(group_ + 0, offsets_, 4)));
+                    const __m256i y_ = split_by_3_x4(_mm256_cvtepu32_epi64(_mm_i32gather_epi32(group_ + 1, offsets_, 4)));
+                    const __m256i z_ = split_by_3_x4(_mm256_cvtepu32_epi64(_mm_i32gather_epi32(group_ + 2, offsets_, 4)));
+                    const __m256i code_ = _mm256_or_si256(x_, _mm256_or_si256(_mm256_slli_epi64(y_, 1), _mm256_slli_epi64(z_, 2)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_ + i), code_);
+                }
+                return i;
+            } 
+            else 
+            {
+                // the 32 bit gathers read a little past the z component, the last position 
+                // is always left to the caller so they never leave the input
+                constexpr int STRIDE = 3 * sizeof(component_type);
+                const __m256i offsets_ = _mm256_setr_epi32(0, STRIDE, 2*STRIDE, 3*STRIDE, 4*STRIDE, 5*STRIDE, 6*STRIDE, 7*STRIDE);
+                const __m256i component_mask_ = _mm256_set1_epi32(static_cast<int>(std::numeric_limits<component_type>::max()));
+                const auto* base_ = reinterpret_cast<const char*>(positions_);
+                size_t i = 0;
+                for(; i + 9 <= count_; i += 8) 
+                {
+                    const char* group_ = base_ + i * STRIDE;
+                    __m256i axes_[3];
+                    for(size_t axis_ = 0; axis_ < 3; ++axis_) {
+                        const __m256i value_ = _mm256_i32gather_epi32(reinterpret_cast<const int*>(group_ + axis_ * sizeof(component_type)), offsets_, 1);
+                        axes_[axis_] = split_by_3_x8(_mm256_and_si256(value_, component_mask_)); }
+                    const __m256i code_ = _mm256_or_si256(axes_[0], _mm256_or_si256(_mm256_slli_epi32(axes_[1], 1), _mm256_slli_epi32(axes_[2], 2)));
+
+                    if constexpr (BIT_WIDTH == morton_32b) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_ + i), code_);
+                    } else {
+                        // packs within 128 bit halves, the permute brings both halves together
+                        const __m256i packed_ = _mm256_permute4x64_epi64(_mm256_packus_epi32(code_, code_), 0x08);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ + i), _mm256_castsi256_si128(packed_));
+                    }
+                }
+                return i;
+            }
+        }
+
+        SVO_TARGET("avx2")
+        static size_t decode_avx2(const morton_type* mortons_, component_type* out_, size_t count_)
+        {
+            constexpr size_t LANES = BIT_WIDTH == morton_64b ? 4 : 8;
+            size_t i = 0;
+            for(; i + LANES <= count_; i += LANES) 
+            {
+                std::array<std::array<uint64_t, LANES>, 3> axes_{};
+                if constexpr (BIT_WIDTH == morton_64b) 
+                {
+                    const __m256i code_ = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mortons_ + i));
+                    for(int axis_ = 0; axis_ < 3; ++axis_) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(axes_[axis_].data()), compact_by_3_x4(_mm256_srli_epi64(code_, axis_))); }
+                } 
+                else 
+                {
+                    const __m256i code_ = BIT_WIDTH == morton_32b ? 
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mortons_ + i)) : 
+                        _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mortons_ + i)));
+                    for(int axis_ = 0; axis_ < 3; ++axis_) {
+                        // widened to 64 bit lanes so every axis shares one layout
+                        const __m256i value_ = compact_by_3_x8(_mm256_srli_epi32(code_, axis_));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(axes_[axis_].data()),     _mm256_cvtepu32_epi64(_mm256_castsi256_si128(value_)));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(axes_[axis_].data() + 4), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(value_, 1)));
+                    }
+                }
+
+                for(size_t lane_ = 0; lane_ < LANES; ++lane_) {
+                    for(size_t axis_ = 0; axis_ < 3; ++axis_) {
+                        out_[(i + lane_) * 3 + axis_] = static_cast<component_type>(axes_[axis_][lane_]); }
+                }
+            }
+            return i;
+        }
+    #endif
     };
 
     ///////////////////////////////
@@ -175,7 +883,7 @@ namespace rapid_svo
         std::is_move_assignable_v       <payload_t>>>
     struct spatial
     {
-        using size_type = std::conditional_t<BIT_WIDTH == morton_16b, uint16_t, uint32_t>;
+        using size_type = morton_util<BIT_WIDTH>::morton_type;
 
         size_type 
         _morton{};
@@ -251,6 +959,9 @@ namespace rapid_svo
 
     template<typename T>
     using spatial_32b = spatial<T, morton_32b>;
+
+    template<typename T>
+    using spatial_64b = spatial<T, morton_64b>;
     ///////////////////////////////
 
     struct basic_voxel_format
@@ -328,6 +1039,8 @@ namespace rapid_svo
             out_ = val;
             return *this;
         }
+
+        bool operator==(const basic_voxel_format&) const = default;
     };
 
     struct node_format
@@ -341,487 +1054,6026 @@ namespace rapid_svo
         uint8_t 
         _mask{};
 
+        // children changed since the last tree::consume_dirty(), lives in what was padding
+        uint8_t 
+        _dirty{};
+
+        // collapsed subtree, every voxel below holds the value at slot 0 of voxel block _block_index
+        uint8_t 
+        _uniform{};
+
         [[nodiscard]] 
         bool has_children() const {
             return _mask & 0xFF;
         }
     };
 
-    template<typename T>
-    struct mem_pool 
+    ////////////////////////
+    // read-only node of frozen_tree, only present children are stored and they are 
+    // laid out consecutively, child i lives at first_child() + popcount(mask() & (bit_i - 1)), 
+    // packed into 4 bytes as a 24 bit first child index and the 8 bit mask, so a frozen 
+    // tree holds at most 2^24 nodes and 2^24 voxels
+    ////////////////////////
+    struct frozen_node_format
     {
-        std::vector<std::array<T, 8>>
-        _blocks{};
+        inline static constexpr uint32_t 
+        MAX_INDEX = (1u << 24) - 1;
 
-        std::queue<uint32_t>
-        _free{};
+        constexpr frozen_node_format() = default;
 
-        uint32_t acquire_next_index()
+        constexpr frozen_node_format(uint32_t first_child_, uint8_t mask_) : 
+            _packed(first_child_ | (static_cast<uint32_t>(mask_) << 24))
         {
-            if(_free.size() > 0) {
-                return _free.front();
-            } else {
-                return static_cast<uint32_t>(_blocks.size()); 
-            }
+            assert(first_child_ <= MAX_INDEX);
         }
 
-        uint32_t alloc()
-        {
-            if(_free.size() > 0) {
-                uint32_t index = _free.front();
-                _free.pop();
-                return index;
-            } else {
-                _blocks.emplace_back();
-                return static_cast<uint32_t>(_blocks.size())-1; 
-            }
-        }
+        [[nodiscard]] 
+        uint32_t first_child() const { return _packed & MAX_INDEX; }
 
-        void dealloc(uint32_t index)
+        [[nodiscard]] 
+        uint8_t mask() const { return static_cast<uint8_t>(_packed >> 24); }
+
+        void set_first_child(uint32_t first_child_)
         {
-            _free.push(index);
+            assert(first_child_ <= MAX_INDEX);
+            _packed = (_packed & ~MAX_INDEX) | first_child_;
         }
-    };
-    
-    struct details_info
-    {
-        bool 
-        _discard_overflow = false;
 
-        std::array<uint32_t, 3> 
-        _limit_max_bounds{}; 
+        bool operator==(const frozen_node_format&) const = default;
+
+        uint32_t
+        _packed{};
     };
 
-    template<bit_width BIT_WIDTH, typename FORMAT_T = basic_voxel_format, details_info DETAILS = {},
-    typename = std::enable_if_t<
-        std::is_default_constructible_v <FORMAT_T> &&
-        std::is_copy_constructible_v    <FORMAT_T> &&
-        std::is_copy_assignable_v       <FORMAT_T> &&
-        std::is_move_constructible_v    <FORMAT_T> &&
-        std::is_move_assignable_v       <FORMAT_T>>>
-    class tree
-    {   
-    public:
+    static_assert(sizeof(frozen_node_format) == 4);
 
-        uint64_t byte_size()
-        {
-            auto size = sizeof(*this);
-            size += get_node_blocks_count()  * sizeof(node_format) * 8;
-            size += get_voxel_blocks_count() * sizeof(FORMAT_T) * 8;
-            return size;
-        }
+    ////////////////////////
+    // tree::save() file layout, little-endian: the header, node blocks from node_offset and voxel 
+    // blocks from voxel_offset, both 64 byte aligned, block indices are compacted and blocks are 
+    // laid out depth-first from the root block (index 0) so a subtree shares pages with its parent
+    ////////////////////////
+    struct snapshot_header
+    {
+        inline static constexpr std::array<char, 8> 
+        MAGIC = {'R','S','V','O','S','N','A','P'};
 
-        ////////////////////////
-        // 16b: 8^5  == 32^3
-        // 32b: 8^10 == 1024^3
-        ////////////////////////
         inline static constexpr uint32_t 
-        SPACE_ABSOLUTE_MAX_DEPTH = BIT_WIDTH == morton_16b ? 5 : 10; 
+        VERSION = 1;
 
-        inline static constexpr uint32_t 
-        ABSOLUTE_AXIS_WIDTH = 1 << SPACE_ABSOLUTE_MAX_DEPTH;
+        std::array<char, 8> 
+        _magic{};
 
-        inline static constexpr std::array<uint16_t, 3>
-        BOUNDS = {
-        DETAILS._limit_max_bounds[0] > 0 ? util::min(DETAILS._limit_max_bounds[0], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH,
-        DETAILS._limit_max_bounds[1] > 0 ? util::min(DETAILS._limit_max_bounds[1], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH,
-        DETAILS._limit_max_bounds[2] > 0 ? util::min(DETAILS._limit_max_bounds[2], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH};
+        uint32_t 
+        _version{};
+
+        uint32_t 
+        _bit_width{};
+
+        uint32_t 
+        _max_depth{};
+
+        uint32_t 
+        _voxel_size{};
+
+        std::array<uint32_t, 3> 
+        _bounds{};
+
+        uint32_t 
+        _node_blocks{};
+
+        uint32_t 
+        _voxel_blocks{};
+
+        uint32_t 
+        _root_mask{};
+
+        uint64_t 
+        _node_offset{};
+
+        uint64_t 
+        _voxel_offset{};
+    };
+
+    static_assert(sizeof(snapshot_header) == 64);
+
+    // node_format without padding bytes of unspecified value
+    struct snapshot_node_format
+    {
+        uint32_t
+        _block_index{};
         
-        inline static constexpr uint32_t calc_bounds_max_depth() {
-            constexpr uint32_t res_ = util::log2(util::max(util::max(BOUNDS[0], BOUNDS[1]), BOUNDS[2])); 
-            return util::max(res_, 3u);
+        uint8_t 
+        _depth{};
+        
+        uint8_t 
+        _mask{};
+
+        uint16_t 
+        _reserved{};
+    };
+
+    static_assert(sizeof(snapshot_node_format) == 8);
+
+    ////////////////////////
+    // voxel face a ray entered through, face_none when the ray starts inside the hit voxel
+    ////////////////////////
+    enum voxel_face : uint8_t
+    {
+        face_none,
+        face_neg_x,
+        face_pos_x,
+        face_neg_y,
+        face_pos_y,
+        face_neg_z,
+        face_pos_z
+    };
+
+    ////////////////////////
+    // which voxels tree::find_components() takes as connected, those sharing a face (6 neighbours) 
+    // or those sharing a face, an edge or a corner (26 neighbours)
+    ////////////////////////
+    enum voxel_connectivity : uint8_t
+    {
+        connect_faces,
+        connect_all
+    };
+
+    struct ray
+    {
+        glm::vec3 
+        _origin{};
+
+        glm::vec3 
+        _direction{};
+
+        float 
+        _max_distance{};
+    };
+
+    ////////////////////////
+    // LIFO list of free block indices, the link to the next free block is kept in the first 
+    // bytes of the free block itself, so the most recently freed (and likeliest cached) block 
+    // is reused first and the list costs no memory of its own, blocks of types that are not
+    // trivially copyable can not be overwritten and go to a plain index stack instead
+    ////////////////////////
+    template<typename T, size_t BLOCK_SIZE = 8>
+    struct free_list
+    {
+        using block_type = std::array<T, BLOCK_SIZE>;
+
+        inline static constexpr bool 
+        INTRUSIVE = std::is_trivially_copyable_v<T> && sizeof(block_type) >= sizeof(uint32_t);
+
+        inline static constexpr uint32_t 
+        END = ~0u;
+
+        template<typename BLOCKS_T>
+        void push(BLOCKS_T& blocks_, uint32_t index)
+        {
+            if constexpr (INTRUSIVE) {
+                std::memcpy(static_cast<void*>(blocks_[index].data()), &_head, sizeof(_head));
+                _head = index;
+            } else {
+                _stack.push_back(index);
+            }
+            ++_size;
+        }
+
+        template<typename BLOCKS_T>
+        uint32_t pop(BLOCKS_T& blocks_)
+        {
+            assert(_size > 0);
+            --_size;
+            if constexpr (INTRUSIVE) {
+                const uint32_t index = _head;
+                std::memcpy(&_head, static_cast<const void*>(blocks_[index].data()), sizeof(_head));
+                return index;
+            } else {
+                const uint32_t index = _stack.back();
+                _stack.pop_back();
+                return index;
+            }
+        }
+
+        void clear()
+        {
+            _head = END;
+            _stack.clear();
+            _size = 0;
+        }
+
+        [[nodiscard]] 
+        uint32_t size() const { return _size; }
+
+        uint32_t 
+        _head = END;
+
+        uint32_t 
+        _size{};
+
+        std::vector<uint32_t>
+        _stack{};
+    };
+
+    template<typename T, size_t BLOCK_SIZE = 8>
+    struct mem_pool 
+    {
+        std::vector<std::array<T, BLOCK_SIZE>>
+        _blocks{};
+
+        free_list<T, BLOCK_SIZE>
+        _free{};
+
+        uint32_t alloc()
+        {
+            if(_free.size() > 0) {
+                return _free.pop(_blocks);
+            } else {
+                _blocks.emplace_back();
+                return static_cast<uint32_t>(_blocks.size())-1; 
+            }
+        }
+
+        void dealloc(uint32_t index)
+        {
+            _free.push(_blocks, index);
+        }
+
+        // takes over blocks laid out by tree::compact(), every one of them in use
+        void assign_compacted(std::vector<std::array<T, BLOCK_SIZE>>&& blocks)
+        {
+            _blocks = std::move(blocks);
+            _blocks.shrink_to_fit();
+            _free.clear();
+        }
+
+        // make room for additional blocks up front so that alloc() does not relocate _blocks
+        void reserve(uint32_t additional)
+        {
+            const size_t free_ = _free.size();
+            const size_t required_ = _blocks.size() + (additional > free_ ? additional - free_ : 0);
+            if(required_ > _blocks.capacity()) {
+                _blocks.reserve(std::max(required_, _blocks.capacity() + _blocks.capacity() / 2));
+            }
+        }
+
+        [[nodiscard]] 
+        uint32_t used_count() const
+        {
+            return static_cast<uint32_t>(_blocks.size() - _free.size());
+        }
+
+        [[nodiscard]] 
+        uintptr_t block_address(uint32_t index) const
+        {
+            return reinterpret_cast<uintptr_t>(_blocks.data() + index);
+        }
+    };
+
+    ////////////////////////
+    // block storage that never relocates, segment s holds SEGMENT_BASE << s blocks so an index 
+    // maps to its segment with a single bit_width and the segment table never has to grow
+    ////////////////////////
+    template<typename T>
+    struct stable_blocks
+    {
+        using block_type = std::array<T, 8>;
+
+        inline static constexpr uint32_t 
+        SEGMENT_BASE_BITS = 8;
+
+        inline static constexpr uint64_t 
+        SEGMENT_BASE = uint64_t{1} << SEGMENT_BASE_BITS;
+
+        inline static constexpr uint32_t 
+        SEGMENTS = 33 - SEGMENT_BASE_BITS;
+
+        stable_blocks() = default;
+        stable_blocks(const stable_blocks&) = delete;
+        stable_blocks& operator=(const stable_blocks&) = delete;
+
+        ~stable_blocks()
+        {
+            for(auto& segment_ : _segments) {
+                delete[] segment_.load(std::memory_order_relaxed); }
+        }
+
+        block_type& operator [] (uint32_t index) {
+            return locate(index);
+        }
+
+        const block_type& operator [] (uint32_t index) const {
+            return locate(index);
+        }
+
+        [[nodiscard]] 
+        size_t size() const {
+            return _size.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] 
+        size_t capacity() const {
+            return static_cast<size_t>(SEGMENT_BASE * ((uint64_t{1} << _segment_count) - 1));
+        }
+
+        void reserve(size_t count_) 
+        {
+            while(capacity() < count_) 
+            {
+                const uint64_t blocks_ = SEGMENT_BASE << _segment_count;
+                block_type* segment_ = new block_type[blocks_]();
+                _segments[_segment_count].store(segment_, std::memory_order_relaxed);
+                _bases[_segment_count].store(reinterpret_cast<uintptr_t>(segment_) - static_cast<uintptr_t>(blocks_ * sizeof(block_type)), 
+                    std::memory_order_release);
+                ++_segment_count;
+            }
+        }
+
+        // only grows, new blocks are value initialized when their segment is created
+        void resize(size_t count_) 
+        {
+            assert(count_ >= size());
+            reserve(count_);
+            _size.store(static_cast<uint32_t>(count_), std::memory_order_release);
+        }
+
+        void emplace_back() {
+            resize(size() + 1);
+        }
+
+        // releases the segments past count_, nothing may be reading them
+        void shrink(size_t count_) 
+        {
+            assert(count_ <= size());
+            while(_segment_count > 1 && SEGMENT_BASE * ((uint64_t{1} << (_segment_count - 1)) - 1) >= count_) 
+            {
+                --_segment_count;
+                delete[] _segments[_segment_count].exchange(nullptr, std::memory_order_relaxed);
+                _bases[_segment_count].store(0, std::memory_order_relaxed);
+            }
+            _size.store(static_cast<uint32_t>(count_), std::memory_order_release);
+        }
+
+        [[nodiscard]] 
+        uintptr_t block_address(uint32_t index) const
+        {
+            const uint64_t slot_ = uint64_t{index} + SEGMENT_BASE;
+            const uint32_t segment_ = static_cast<uint32_t>(std::bit_width(slot_)) - 1 - SEGMENT_BASE_BITS;
+            return _bases[segment_].load(std::memory_order_acquire) + static_cast<uintptr_t>(slot_) * sizeof(block_type);
+        }
+
+    private:
+
+        block_type& locate(uint32_t index) const
+        {
+            return *reinterpret_cast<block_type*>(block_address(index));
+        }
+
+        std::array<std::atomic<block_type*>, SEGMENTS>
+        _segments{};
+
+        // segment address minus the offset of its first slot, a block address is then base + slot
+        std::array<std::atomic<uintptr_t>, SEGMENTS>
+        _bases{};
+
+        uint32_t 
+        _segment_count{};
+
+        std::atomic<uint32_t> 
+        _size{};
+    };
+
+    ////////////////////////
+    // mem_pool of the concurrent tree, blocks never relocate and alloc() / dealloc() may be 
+    // called from several threads, dealloc() only retires a block as readers can still be 
+    // inside it, reclaim() hands retired blocks back to alloc()
+    ////////////////////////
+    template<typename T>
+    struct concurrent_mem_pool 
+    {
+        stable_blocks<T>
+        _blocks{};
+
+        free_list<T>
+        _free{};
+
+        std::vector<uint32_t>
+        _retired{};
+
+        mutable std::mutex
+        _mutex{};
+
+        uint32_t alloc()
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            if(_free.size() > 0) {
+                return _free.pop(_blocks);
+            } else {
+                _blocks.emplace_back();
+                return static_cast<uint32_t>(_blocks.size())-1; 
+            }
+        }
+
+        void dealloc(uint32_t index)
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            _retired.push_back(index);
+        }
+
+        void reclaim()
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            for(const uint32_t index : _retired) {
+                _free.push(_blocks, index); }
+            _retired.clear();
+        }
+
+        // no reader may be inside the pool, retired blocks are dropped with the free ones
+        void assign_compacted(std::vector<std::array<T, 8>>&& blocks)
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            for(size_t i = 0; i < blocks.size(); ++i) {
+                _blocks[static_cast<uint32_t>(i)] = blocks[i]; }
+            _blocks.shrink(blocks.size());
+            _free.clear();
+            _retired.clear();
+        }
+
+        void reserve(uint32_t additional)
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            const size_t free_ = _free.size();
+            const size_t required_ = _blocks.size() + (additional > free_ ? additional - free_ : 0);
+            if(required_ > _blocks.capacity()) {
+                _blocks.reserve(std::max(required_, _blocks.capacity() + _blocks.capacity() / 2));
+            }
+        }
+
+        // retired blocks are no longer in use
+        [[nodiscard]] 
+        uint32_t used_count() const
+        {
+            std::lock_guard<std::mutex> lock_(_mutex);
+            return static_cast<uint32_t>(_blocks.size() - _free.size() - _retired.size());
+        }
+
+        [[nodiscard]] 
+        uintptr_t block_address(uint32_t index) const
+        {
+            return _blocks.block_address(index);
+        }
+    };
+    
+    ////////////////////////
+    // per node summary kept by trees with details_info::_aggregate, reduced from the voxel block 
+    // of a deepest level node and from the children's summaries above it, of() gets the block of 
+    // 8 and the mask of the present entries, specialize it for a voxel_format to reduce anything else
+    ////////////////////////
+    template<typename FORMAT_T>
+    struct voxel_aggregate
+    {
+        // voxels in the subtree
+        uint64_t 
+        _count{};
+
+        static voxel_aggregate of(const FORMAT_T*, uint8_t mask_)
+        {
+            return {static_cast<uint64_t>(std::popcount(mask_))};
+        }
+
+        static voxel_aggregate of(const voxel_aggregate* children_, uint8_t mask_)
+        {
+            voxel_aggregate out_{};
+            for(; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                out_._count += children_[std::countr_zero(mask_)]._count; }
+            return out_;
+        }
+    };
+
+    template<>
+    struct voxel_aggregate<basic_voxel_format>
+    {
+        // voxels in the subtree
+        uint64_t 
+        _count{};
+
+        // the children's majority type covering the most voxels, exact one level above voxels, 
+        // ties go to the lower type
+        uint16_t 
+        _type_info{};
+
+        static voxel_aggregate of(const basic_voxel_format* voxels_, uint8_t mask_)
+        {
+            std::array<voxel_aggregate, 8> singles_{};
+            for(uint8_t pending_ = mask_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) 
+            {
+                const auto index_ = std::countr_zero(pending_);
+                basic_voxel_format voxel_ = voxels_[index_];
+                voxel_.get_type_info(singles_[index_]._type_info);
+                singles_[index_]._count = 1;
+            }
+            return of(singles_.data(), mask_);
+        }
+
+        static voxel_aggregate of(const voxel_aggregate* children_, uint8_t mask_)
+        {
+            // solid regions mostly hold one type, summed without weighing
+            voxel_aggregate out_{0, mask_ != 0 ? children_[std::countr_zero(mask_)]._type_info : uint16_t{}};
+            bool single_type_ = true;
+            for(uint8_t pending_ = mask_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) {
+                const auto& child_ = children_[std::countr_zero(pending_)];
+                out_._count += child_._count;
+                single_type_ &= child_._type_info == out_._type_info; }
+            if(single_type_) {
+                return out_; }
+
+            type_weights weights_{};
+            for(; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                const auto& child_ = children_[std::countr_zero(mask_)];
+                weights_.add(child_._type_info, child_._count); }
+            return weights_.reduce();
         }
 
+    private:
+
+        // at most 8 distinct types, each weighted with the voxels holding it
+        struct type_weights
+        {
+            std::array<uint16_t, 8>
+            _types{};
+
+            std::array<uint64_t, 8>
+            _weights{};
+
+            uint32_t 
+            _distinct{};
+
+            void add(uint16_t type_info_, uint64_t weight_)
+            {
+                uint32_t i = 0;
+                while(i < _distinct && _types[i] != type_info_) {
+                    ++i; }
+                if(i == _distinct) {
+                    _types[_distinct++] = type_info_; }
+                _weights[i] += weight_;
+            }
+
+            voxel_aggregate reduce() const
+            {
+                voxel_aggregate out_{};
+                uint64_t best_ = 0;
+                for(uint32_t i = 0; i < _distinct; ++i)
+                {
+                    out_._count += _weights[i];
+                    if(_weights[i] > best_ || (_weights[i] == best_ && _types[i] < out_._type_info)) {
+                        best_ = _weights[i];
+                        out_._type_info = _types[i];
+                    }
+                }
+                return out_;
+            }
+        };
+    };
+
+    ////////////////////////
+    // payload merge policies for the tree CSG operations, called where both trees hold a voxel 
+    // as merge(const voxel_format& target, const voxel_format& source) -> voxel_format
+    ////////////////////////
+    struct take_source_voxel
+    {
+        template<typename T>
+        const T& operator()(const T&, const T& source_) const { return source_; }
+    };
+
+    struct keep_target_voxel
+    {
+        template<typename T>
+        const T& operator()(const T& target_, const T&) const { return target_; }
+    };
+
+    struct details_info
+    {
+        bool 
+        _discard_overflow = false;
+
+        std::array<uint32_t, 3> 
+        _limit_max_bounds{}; 
+
+        // stable block storage, get(), get_bulk() and the neighborhood fetches stay lock-free while 
+        // alloc() / dealloc() run on other threads and writers of different top level octants do not 
+        // block each other, bulk allocs and the other queries still need the tree to themselves
+        bool 
+        _concurrent = false;
+
+        // alloc() / dealloc() / the bulk allocs flag the nodes they pass through for consume_dirty()
+        bool 
+        _track_dirty = false;
+
+        // tree::collapse_uniform() folds fully occupied single value subtrees into one node, writes 
+        // into them expand them again level by level, needs voxel_format to be equality comparable
+        bool 
+        _collapse_uniform = false;
+
+        // every node keeps a voxel_aggregate of its subtree for tree::get_lod(), alloc() / dealloc() 
+        // reduce the path they pass through again, the bulk allocs and compact() rebuild them all
+        bool 
+        _aggregate = false;
+    };
+
+    template<typename TREE_T>
+    class frozen_tree;
+
+    template<typename TREE_T>
+    class tree_view;
+
+    template<typename TREE_T>
+    class dag_tree;
+
+    template<bit_width BIT_WIDTH, typename FORMAT_T = basic_voxel_format, details_info DETAILS = {},
+    typename = std::enable_if_t<
+        std::is_default_constructible_v <FORMAT_T> &&
+        std::is_copy_constructible_v    <FORMAT_T> &&
+        std::is_copy_assignable_v       <FORMAT_T> &&
+        std::is_move_constructible_v    <FORMAT_T> &&
+        std::is_move_assignable_v       <FORMAT_T>>>
+    class tree
+    {   
+    public:
+
+        uint64_t byte_size()
+        {
+            auto size = sizeof(*this);
+            size += get_node_blocks_count()  * sizeof(node_format) * 8;
+            size += get_voxel_blocks_count() * sizeof(FORMAT_T) * 8;
+            if constexpr (DETAILS._aggregate) {
+                size += _aggregates._blocks.size() * sizeof(aggregate_type) * 8; }
+            return size;
+        }
+
+        ////////////////////////
+        // 16b: 8^5  == 32^3
+        // 32b: 8^10 == 1024^3
+        // 64b: 8^21 == 2097152^3
+        ////////////////////////
+        inline static constexpr uint32_t 
+        SPACE_ABSOLUTE_MAX_DEPTH = 
+            BIT_WIDTH == morton_16b ? 5 : 
+            BIT_WIDTH == morton_32b ? 10 : 
+            21; 
+
+        inline static constexpr uint32_t 
+        ABSOLUTE_AXIS_WIDTH = 1 << SPACE_ABSOLUTE_MAX_DEPTH;
+
+        inline static constexpr std::array<uint32_t, 3>
+        BOUNDS = {
+        DETAILS._limit_max_bounds[0] > 0 ? util::min(DETAILS._limit_max_bounds[0], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH,
+        DETAILS._limit_max_bounds[1] > 0 ? util::min(DETAILS._limit_max_bounds[1], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH,
+        DETAILS._limit_max_bounds[2] > 0 ? util::min(DETAILS._limit_max_bounds[2], ABSOLUTE_AXIS_WIDTH) : ABSOLUTE_AXIS_WIDTH};
+        
+        inline static constexpr uint32_t calc_bounds_max_depth() {
+            constexpr uint32_t res_ = util::log2(util::max(util::max(BOUNDS[0], BOUNDS[1]), BOUNDS[2])); 
+            return util::max(res_, 3u);
+        }
+
+        inline static constexpr uint32_t 
+        MAX_DEPTH = calc_bounds_max_depth(); 
+        
+        inline static constexpr uint32_t 
+        AXIS_WIDTH = 1 << MAX_DEPTH;
+       
+        inline static constexpr uint64_t 
+        MAX_SIZE = 
+            uint64_t{AXIS_WIDTH}*
+            AXIS_WIDTH*
+            AXIS_WIDTH; 
+        ////////////////////////
+        
+        [[nodiscard]] 
+        static constexpr bit_width get_type() { return BIT_WIDTH; }
+
+        [[nodiscard]] 
+        static constexpr details_info details() { return DETAILS; }
+
+        using voxel_format = FORMAT_T;
+
+        using spatial_node = spatial<node_format, BIT_WIDTH>;
+
+        using spatial_voxel = spatial<voxel_format, BIT_WIDTH>;
+        
+        using component_type = morton_util<BIT_WIDTH>::component_type;
+
+        using signed_component_type = morton_util<BIT_WIDTH>::signed_component_type;
+
+        using morton_type = morton_util<BIT_WIDTH>::morton_type;
+        
+        using vector_type = glm::vec<3, component_type>;
+
+        using aggregate_type = voxel_aggregate<FORMAT_T>;
+
+        ////////////////////////
+        // per axis bounds in dilated morton space, zero when the axis spans the whole AXIS_WIDTH
+        ////////////////////////
+        inline static constexpr std::array<morton_type, 3>
+        MORTON_BOUNDS = {
+        static_cast<morton_type>(BOUNDS[0] < AXIS_WIDTH ? morton_util<BIT_WIDTH>::dilate(BOUNDS[0]) << 0 : 0),
+        static_cast<morton_type>(BOUNDS[1] < AXIS_WIDTH ? morton_util<BIT_WIDTH>::dilate(BOUNDS[1]) << 1 : 0),
+        static_cast<morton_type>(BOUNDS[2] < AXIS_WIDTH ? morton_util<BIT_WIDTH>::dilate(BOUNDS[2]) << 2 : 0)};
+
+        [[nodiscard]] 
+        static constexpr bool is_overflow(morton_type morton)
+        {
+            bool overflow = (morton >> (3 * MAX_DEPTH)) != 0;
+            LOOP_UNROLL
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                if(MORTON_BOUNDS[axis_] != 0) {
+                    const auto axis_mask_ = static_cast<morton_type>(morton_util<BIT_WIDTH>::AXIS_MASK << axis_);
+                    overflow |= static_cast<morton_type>(morton & axis_mask_) >= MORTON_BOUNDS[axis_];
+                }
+            }
+            return overflow;
+        }
+    
+    private:
+
+        inline static const node_format EMPTY_NODE{};
+
+        // stands in for the block of the root node where nodes are addressed by block and slot
+        inline static constexpr uint32_t ROOT_BLOCK = ~0u;
+
+        // no piece of a component search, an empty octant or nothing inside the box
+        inline static constexpr uint32_t NO_PIECE = ~0u;
+
+        static_assert(!DETAILS._collapse_uniform || (!DETAILS._concurrent && std::equality_comparable<FORMAT_T>), 
+            "collapsing needs an equality comparable voxel_format and no concurrent mode");
+
+        static_assert(!DETAILS._aggregate || (!DETAILS._concurrent && !DETAILS._collapse_uniform), 
+            "aggregates are not kept in concurrent mode or with collapsing");
+
+        void get_bulk_lanes(const morton_type* voxel_mortons, voxel_format** out, uint32_t lanes, uint32_t live)
+        {
+            static_assert(!DETAILS._collapse_uniform, "get_bulk() does not descend into collapsed subtrees");
+            std::array<const node_format*, BULK_LANES> nodes_{};
+            std::array<morton_type, BULK_LANES> mortons_{};
+            for(uint32_t lane_ = 0; lane_ < BULK_LANES; ++lane_) {
+                const bool live_ = lane_ < lanes && ((live >> lane_) & 1u);
+                nodes_[lane_] = live_ ? &_root_node : &EMPTY_NODE;
+                mortons_[lane_] = lane_ < lanes ? voxel_mortons[lane_] : 0;
+            }
+
+            LOOP_UNROLL
+            for(uint32_t depth_ = 0; depth_ < MAX_DEPTH-1; ++depth_)
+            {
+                const uint32_t shift_ = 3 * (MAX_DEPTH - 1 - depth_);
+                LOOP_UNROLL
+                for(uint32_t lane_ = 0; lane_ < BULK_LANES; ++lane_)
+                {
+                    const node_format* node_ = nodes_[lane_];
+                    const uint32_t index = static_cast<uint32_t>(mortons_[lane_] >> shift_) & 7u;
+                    const node_format* child_ = &_node_pool._blocks[load_block_index(*node_)][index];
+                    SVO_PREFETCH(child_);
+                    nodes_[lane_] = (load_mask(*node_) >> index) & 1u ? child_ : &EMPTY_NODE;
+                }
+            }
+
+            for(uint32_t lane_ = 0; lane_ < lanes; ++lane_)
+            {
+                const node_format* node_ = nodes_[lane_];
+                const uint32_t index = static_cast<uint32_t>(mortons_[lane_]) & 7u;
+                out[lane_] = (load_mask(*node_) >> index) & 1u ? 
+                    &_voxel_pool._blocks[load_block_index(*node_)][index] : 
+                    nullptr;
+            }
+        }
+
+        template<typename T>
+        using pool_type = std::conditional_t<DETAILS._concurrent, concurrent_mem_pool<T>, mem_pool<T>>;
+
+        struct octant_locks
+        {
+            std::array<std::mutex, 8>
+            _octants{};
+        };
+
+        struct no_locks {};
+
+        node_format
+        _root_node{};
+
+        pool_type<node_format>
+        _node_pool{};
+
+        pool_type<voxel_format>
+        _voxel_pool{};
+
+        [[no_unique_address]] 
+        std::conditional_t<DETAILS._concurrent, octant_locks, no_locks>
+        _writer_locks{};
+
+        // the children of a node block have their aggregates side by side at the same block index, 
+        // so reducing a node reads one contiguous block
+        struct node_aggregates
+        {
+            std::vector<std::array<aggregate_type, 8>>
+            _blocks{};
+
+            aggregate_type
+            _root{};
+        };
+
+        struct no_aggregates {};
+
+        [[no_unique_address]] 
+        std::conditional_t<DETAILS._aggregate, node_aggregates, no_aggregates>
+        _aggregates{};
+
+        ////////////////////////
+        // in concurrent mode masks and block indices are accessed atomically, a writer fills a 
+        // child in completely before its mask bit is released, so a reader acquiring the bit 
+        // always sees a complete child
+        ////////////////////////
+        static uint8_t load_mask(const node_format& node_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                return std::atomic_ref<uint8_t>(const_cast<uint8_t&>(node_._mask)).load(std::memory_order_acquire);
+            } else {
+                return node_._mask;
+            }
+        }
+
+        static uint32_t load_block_index(const node_format& node_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                return std::atomic_ref<uint32_t>(const_cast<uint32_t&>(node_._block_index)).load(std::memory_order_relaxed);
+            } else {
+                return node_._block_index;
+            }
+        }
+
+        static void store_node(node_format& slot_, const node_format& node_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                std::atomic_ref<uint32_t>(slot_._block_index).store(node_._block_index, std::memory_order_relaxed);
+                std::atomic_ref<uint8_t>(slot_._mask).store(node_._mask, std::memory_order_relaxed);
+                slot_._depth = node_._depth;
+                slot_._dirty = node_._dirty;
+            } else {
+                slot_ = node_;
+            }
+        }
+
+        static void set_mask_bits(node_format& node_, uint8_t bits_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                std::atomic_ref<uint8_t>(node_._mask).fetch_or(bits_, std::memory_order_release);
+            } else {
+                node_._mask |= bits_;
+            }
+        }
+
+        // writers of different octants share the root, so its dirty bits are set atomically too
+        static void set_dirty_bits(node_format& node_, uint8_t bits_)
+        {
+            if constexpr (DETAILS._track_dirty) {
+                if constexpr (DETAILS._concurrent) {
+                    std::atomic_ref<uint8_t>(node_._dirty).fetch_or(bits_, std::memory_order_relaxed);
+                } else {
+                    node_._dirty |= bits_;
+                }
+            }
+        }
+
+        // returns the bits left set
+        static uint8_t clear_mask_bits(node_format& node_, uint8_t bits_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                return std::atomic_ref<uint8_t>(node_._mask).fetch_and(static_cast<uint8_t>(~bits_), std::memory_order_release) & ~bits_;
+            } else {
+                return node_._mask &= ~bits_;
+            }
+        }
+
+        // writers of the same top level octant share everything below the root node
+        [[nodiscard]] 
+        auto lock_octant(morton_type voxel_morton)
+        {
+            if constexpr (DETAILS._concurrent) {
+                return std::unique_lock<std::mutex>(_writer_locks._octants[(voxel_morton >> (3 * (MAX_DEPTH - 1))) & 7u]);
+            } else {
+                return no_locks{};
+            }
+        }
+
+        // lock_octant() for every octant in octants_, taken in index order so writers never deadlock
+        [[nodiscard]] 
+        auto lock_octants(uint8_t octants_)
+        {
+            if constexpr (DETAILS._concurrent) {
+                std::array<std::unique_lock<std::mutex>, 8> locks_{};
+                for(; octants_ != 0; octants_ &= static_cast<uint8_t>(octants_ - 1)) {
+                    const auto index_ = std::countr_zero(octants_);
+                    locks_[index_] = std::unique_lock<std::mutex>(_writer_locks._octants[index_]); }
+                return locks_;
+            } else {
+                return no_locks{};
+            }
+        }
+
+    public:
+
+        tree()
+        {
+            _root_node = {};
+            _root_node._depth = 0;
+            _root_node._block_index = _node_pool.alloc();
+        }
+
+        [[nodiscard]] 
+        uint32_t get_node_blocks_count() const
+        {
+            return _node_pool.used_count();
+        }
+        
+        [[nodiscard]] 
+        uint32_t get_voxel_blocks_count() const
+        {
+            return _voxel_pool.used_count();
+        }
+
+        void alloc_bulk(spatial_voxel* voxels, uint32_t count)
+        {
+            ////////////////////////
+            //   SORT BY MORTON   //
+            ////////////////////////
+            // voxels sharing a morton prefix share the whole node path above it, so once sorted 
+            // every node is resolved once and each voxel only walks the levels below the prefix 
+            // it shares with its predecessor
+            std::vector<util::sort_entry<morton_type>> sorted_{};
+            sorted_.reserve(count);
+
+            bool is_sorted_ = true;
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                const morton_type morton_ = voxels[i]._morton;
+                const bool overflow = is_overflow(morton_);
+
+                if constexpr (DETAILS._discard_overflow){   
+                    if(overflow) { continue; } 
+                } else {
+                    assert(!overflow);
+                }
+
+                is_sorted_ &= sorted_.empty() || (sorted_.back()._key >> 3) <= (morton_ >> 3);
+                sorted_.push_back({morton_, i});
+            }
+
+            if(sorted_.empty()) {
+                return; }
+
+            // the build only knows plain nodes, a fresh tree stops at the root right away
+            if constexpr (DETAILS._collapse_uniform) {
+                for(const auto& entry_ : sorted_) {
+                    expand_path(entry_._key, nullptr); }
+            }
+
+            // only the voxel block prefix needs ordering, the stable sort keeps voxels of the 
+            // same block in input order so a later duplicate still overwrites an earlier one
+            if(!is_sorted_) {
+                util::radix_sort(sorted_, 3 * (MAX_DEPTH - 1), 3);
+            }
+
+            bulk_build(_node_pool, _voxel_pool, &_root_node, 0, sorted_.data(), sorted_.size(), voxels);
+
+            if constexpr (DETAILS._aggregate) {
+                refresh_aggregates(); }
+        }
+
+        ////////////////////////
+        // alloc_bulk spread over threads, the input is partitioned by the top PARALLEL_PARTITION_DEPTH 
+        // levels of the morton code and every partition subtree is sorted and built on a worker 
+        // into pools of its own, which are then appended to the tree pools with their block indices 
+        // rebased, partitions whose subtree already exists are merged on the calling thread, 
+        // thread_count 0 uses std::thread::hardware_concurrency()
+        ////////////////////////
+        inline static constexpr uint32_t 
+        PARALLEL_PARTITION_DEPTH = MAX_DEPTH >= 4 ? 2 : 1;
+
+        inline static constexpr uint32_t 
+        PARALLEL_PARTITIONS = 1u << (3 * PARALLEL_PARTITION_DEPTH);
+
+        void alloc_bulk_parallel(spatial_voxel* voxels, uint32_t count, uint32_t thread_count = 0)
+        {
+            if(thread_count == 0) {
+                thread_count = util::max(std::thread::hardware_concurrency(), 1u); }
+
+            ////////////////////////
+            //     PARTITION      //
+            ////////////////////////
+            constexpr uint32_t PARTITION_SHIFT = 3 * (MAX_DEPTH - PARALLEL_PARTITION_DEPTH);
+
+            std::array<uint32_t, PARALLEL_PARTITIONS> partition_counts_{};
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                const morton_type morton_ = voxels[i]._morton;
+                const bool overflow = is_overflow(morton_);
+
+                if constexpr (DETAILS._discard_overflow){   
+                    if(overflow) { continue; } 
+                } else {
+                    assert(!overflow);
+                }
+
+                ++partition_counts_[morton_ >> PARTITION_SHIFT];
+            }
+
+            if constexpr (DETAILS._collapse_uniform) {
+                for(uint32_t i = 0; i < count; ++i) {
+                    if(!is_overflow(voxels[i]._morton)) {
+                        expand_path(voxels[i]._morton, nullptr); }
+                }
+            }
+
+            std::vector<partition_build> builds_(PARALLEL_PARTITIONS);
+            for(uint32_t p = 0; p < PARALLEL_PARTITIONS; ++p) {
+                builds_[p]._sorted.reserve(partition_counts_[p]);
+                builds_[p]._local = partition_counts_[p] > 0 && partition_node(p) == nullptr;
+            }
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                const morton_type morton_ = voxels[i]._morton;
+                if constexpr (DETAILS._discard_overflow){   
+                    if(is_overflow(morton_)) { continue; } 
+                }
+
+                auto& build_ = builds_[morton_ >> PARTITION_SHIFT];
+                build_._is_sorted &= build_._sorted.empty() || (build_._sorted.back()._key >> 3) <= (morton_ >> 3);
+                build_._sorted.push_back({morton_, i});
+            }
+
+            ////////////////////////
+            //    LOCAL BUILDS    //
+            ////////////////////////
+            util::parallel_for(PARALLEL_PARTITIONS, thread_count, [&](uint32_t p) 
+            {
+                auto& build_ = builds_[p];
+                if(!build_._local) {
+                    return; }
+
+                if(!build_._is_sorted) {
+                    util::radix_sort(build_._sorted, 3 * (MAX_DEPTH - 1 - PARALLEL_PARTITION_DEPTH), 3); }
+
+                build_._root._depth = PARALLEL_PARTITION_DEPTH;
+                build_._root._block_index = build_._node_pool.alloc();
+                bulk_build(build_._node_pool, build_._voxel_pool, &build_._root, PARALLEL_PARTITION_DEPTH, 
+                    build_._sorted.data(), build_._sorted.size(), voxels);
+                build_._sorted = {};
+            });
+
+            ////////////////////////
+            //       SPLICE       //
+            ////////////////////////
+            auto node_end_  = static_cast<uint32_t>(_node_pool._blocks.size());
+            auto voxel_end_ = static_cast<uint32_t>(_voxel_pool._blocks.size());
+            for(auto& build_ : builds_) 
+            {
+                if(!build_._local) {
+                    continue; }
+                build_._node_base  = node_end_;
+                build_._voxel_base = voxel_end_;
+                node_end_  += static_cast<uint32_t>(build_._node_pool._blocks.size());
+                voxel_end_ += static_cast<uint32_t>(build_._voxel_pool._blocks.size());
+            }
+            _node_pool._blocks.resize(node_end_);
+            _voxel_pool._blocks.resize(voxel_end_);
+
+            // node levels above the deepest point to node blocks, the deepest to voxel blocks
+            util::parallel_for(PARALLEL_PARTITIONS, thread_count, [&](uint32_t p) 
+            {
+                auto& build_ = builds_[p];
+                if(!build_._local) {
+                    return; }
+
+                for(size_t i = 0; i < build_._node_pool._blocks.size(); ++i) 
+                {
+                    auto& block_ = _node_pool._blocks[build_._node_base + i];
+                    block_ = build_._node_pool._blocks[i];
+                    for(auto& node_ : block_) {
+                        node_._block_index += node_._depth < MAX_DEPTH-1 ? build_._node_base : build_._voxel_base; }
+                }
+                for(size_t i = 0; i < build_._voxel_pool._blocks.size(); ++i) {
+                    _voxel_pool._blocks[build_._voxel_base + i] = build_._voxel_pool._blocks[i]; }
+
+                build_._root._block_index += build_._node_base;
+                build_._node_pool = {};
+                build_._voxel_pool = {};
+            });
+
+            for(uint32_t p = 0; p < PARALLEL_PARTITIONS; ++p) {
+                if(builds_[p]._local) {
+                    link_partition(p, builds_[p]._root); }
+            }
+
+            ////////////////////////
+            //  EXISTING SUBTREES //
+            ////////////////////////
+            for(uint32_t p = 0; p < PARALLEL_PARTITIONS; ++p)
+            {
+                auto& build_ = builds_[p];
+                if(build_._local || build_._sorted.empty()) {
+                    continue; }
+
+                if(!build_._is_sorted) {
+                    util::radix_sort(build_._sorted, 3 * (MAX_DEPTH - 1 - PARALLEL_PARTITION_DEPTH), 3); }
+
+                // the build can relocate the pool the partition node lives in, so it works on a copy
+                node_format root_ = *partition_node(p);
+                bulk_build(_node_pool, _voxel_pool, &root_, PARALLEL_PARTITION_DEPTH, 
+                    build_._sorted.data(), build_._sorted.size(), voxels);
+                *partition_node(p) = root_;
+                mark_partition_dirty(p);
+            }
+
+            if constexpr (DETAILS._aggregate) {
+                refresh_aggregates(); }
+        }
+
+        void alloc(vector_type& voxel_position, voxel_format& voxel)
+        { 
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            alloc_impl(voxel_morton, voxel);
+        }
+
+        void alloc(morton_type voxel_morton, voxel_format& voxel)
+        { 
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            alloc_impl(voxel_morton, voxel);
+        }
+
+        voxel_format* get(const vector_type& voxel_position)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_impl(voxel_morton);
+        }
+
+        voxel_format* get(morton_type voxel_morton)
+        {
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_impl(voxel_morton);
+        }
+
+        ////////////////////////
+        // lookups advanced in lock-step per level, BULK_LANES queries at a time, each lane 
+        // prefetches the node it will read on the next level so the misses overlap across lanes
+        ////////////////////////
+        inline static constexpr uint32_t 
+        BULK_LANES = 8;
+
+        void get_bulk(const vector_type* voxel_positions, voxel_format** out, size_t count)
+        {
+            std::array<morton_type, BULK_LANES> mortons_{};
+
+            for(size_t begin_ = 0; begin_ < count; begin_ += BULK_LANES)
+            {
+                const auto lanes_ = static_cast<uint32_t>(util::min<size_t>(BULK_LANES, count - begin_));
+                uint32_t live_ = 0;
+
+                for(uint32_t lane_ = 0; lane_ < lanes_; ++lane_)
+                {
+                    const auto& voxel_position = voxel_positions[begin_ + lane_];
+
+                    const bool overflow = 
+                    voxel_position[0] >= BOUNDS[0] || 
+                    voxel_position[1] >= BOUNDS[1] || 
+                    voxel_position[2] >= BOUNDS[2]; 
+
+                    if constexpr (DETAILS._discard_overflow){   
+                        if(overflow) { continue; } 
+                    } else {
+                        assert(!overflow);
+                    }
+
+                    morton_util<BIT_WIDTH>::pos_to_morton(mortons_[lane_], &voxel_position[0]);
+                    live_ |= 1u << lane_;
+                }
+
+                get_bulk_lanes(&mortons_[0], out + begin_, lanes_, live_);
+            }
+        }
+
+        void get_bulk(const morton_type* voxel_mortons, voxel_format** out, size_t count)
+        {
+            for(size_t begin_ = 0; begin_ < count; begin_ += BULK_LANES)
+            {
+                const auto lanes_ = static_cast<uint32_t>(util::min<size_t>(BULK_LANES, count - begin_));
+                uint32_t live_ = 0;
+
+                for(uint32_t lane_ = 0; lane_ < lanes_; ++lane_)
+                {
+                    const bool overflow = is_overflow(voxel_mortons[begin_ + lane_]);
+
+                    if constexpr (DETAILS._discard_overflow){   
+                        if(overflow) { continue; } 
+                    } else {
+                        assert(!overflow);
+                    }
+
+                    live_ |= 1u << lane_;
+                }
+
+                get_bulk_lanes(voxel_mortons + begin_, out + begin_, lanes_, live_);
+            }
+        }
+
+        bool dealloc(const vector_type& voxel_position)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return dealloc_impl(voxel_morton);
+        }
+
+        bool dealloc(morton_type voxel_morton)
+        {
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return dealloc_impl(voxel_morton);
+        }
+
+        ////////////////////////
+        // removes every voxel inside the box [box_min, box_max] (inclusive) and returns how many, a 
+        // subtree fully inside is released whole without visiting its voxels and only nodes the box 
+        // cuts through are descended, voxel pointers into the box handed out before are invalidated
+        ////////////////////////
+        uint64_t dealloc_box(const vector_type& box_min, const vector_type& box_max)
+        {
+            box_shape shape_{};
+            if(!make_box_shape(box_min, box_max, shape_)) {
+                return 0; }
+            return carve(shape_);
+        }
+
+        // removes every voxel and returns how many, the blocks go back to the pools for reuse
+        uint64_t clear()
+        {
+            return dealloc_box(vector_type(0, 0, 0), vector_type(AXIS_WIDTH - 1, AXIS_WIDTH - 1, AXIS_WIDTH - 1));
+        }
+
+        ////////////////////////
+        // STAMPS
+        // a voxel belongs to a shape when its centre (position + 0.5) does, nodes are classified against 
+        // the shape as a whole: nodes outside are skipped, nodes fully inside are built or released as 
+        // a whole subtree and only nodes on the surface are descended to their voxels, fill_*() writes 
+        // generator(const vector_type& position) -> voxel_format into every voxel of the shape (within 
+        // BOUNDS) and returns how many, carve_*() removes them and returns how many were removed, voxel 
+        // pointers into the shape handed out before are invalidated
+        ////////////////////////
+        template<typename GENERATOR_T>
+        uint64_t fill_box(const vector_type& box_min, const vector_type& box_max, GENERATOR_T&& generator)
+        {
+            box_shape shape_{};
+            if(!make_box_shape(box_min, box_max, shape_)) {
+                return 0; }
+            return fill(shape_, generator);
+        }
+
+        template<typename GENERATOR_T>
+        uint64_t fill_sphere(const glm::vec3& centre, float radius, GENERATOR_T&& generator)
+        {
+            return fill(capsule_shape(centre, centre, radius), generator);
+        }
+
+        uint64_t carve_sphere(const glm::vec3& centre, float radius)
+        {
+            return carve(capsule_shape(centre, centre, radius));
+        }
+
+        template<typename GENERATOR_T>
+        uint64_t fill_capsule(const glm::vec3& a, const glm::vec3& b, float radius, GENERATOR_T&& generator)
+        {
+            return fill(capsule_shape(a, b, radius), generator);
+        }
+
+        uint64_t carve_capsule(const glm::vec3& a, const glm::vec3& b, float radius)
+        {
+            return carve(capsule_shape(a, b, radius));
+        }
+
+        ////////////////////////
+        // concurrent mode only retires the blocks dealloc() frees since get() may still be reading 
+        // them, call reclaim() at a point no reader is inside the tree (e.g. between frames) to make 
+        // them allocatable again, voxel pointers handed out by get() stay valid until then
+        ////////////////////////
+        void reclaim()
+        {
+            if constexpr (DETAILS._concurrent) {
+                _node_pool.reclaim();
+                _voxel_pool.reclaim();
+            }
+        }
+
+        ////////////////////////
+        // relocates the live blocks to the front of the pools in depth-first morton order, so a 
+        // subtree is contiguous and a walk down it runs forward through memory, and releases 
+        // the rest, dealloc churn scatters blocks over the pools and leaves them oversized, 
+        // voxel pointers handed out before are invalidated, in concurrent mode no reader may 
+        // be inside the tree and blocks awaiting reclaim() are released as well
+        ////////////////////////
+        void compact()
+        {
+            std::vector<std::array<node_format, 8>> node_blocks_{};
+            std::vector<std::array<voxel_format, 8>> voxel_blocks_{};
+            node_blocks_.reserve(get_node_blocks_count());
+            voxel_blocks_.reserve(get_voxel_blocks_count());
+
+            // nodes are addressed by block and slot, the new blocks relocate while they fill
+            struct frame { uint32_t _block; uint32_t _index; uint32_t _depth; };
+
+            std::vector<frame> stack_{ {ROOT_BLOCK, 0, 0} };
+            while(!stack_.empty())
+            {
+                const frame frame_ = stack_.back();
+                stack_.pop_back();
+
+                auto node_of_ = [&]() -> node_format& {
+                    return frame_._block == ROOT_BLOCK ? _root_node : node_blocks_[frame_._block][frame_._index]; };
+
+                const node_format node_ = node_of_();
+                // a collapsed subtree is only its value block
+                bool voxel_block_ = frame_._depth == MAX_DEPTH-1;
+                if constexpr (DETAILS._collapse_uniform) {
+                    voxel_block_ = voxel_block_ || node_._uniform; }
+
+                if(voxel_block_) 
+                {
+                    voxel_blocks_.push_back(_voxel_pool._blocks[node_._block_index]);
+                    node_of_()._block_index = static_cast<uint32_t>(voxel_blocks_.size()) - 1;
+                    continue;
+                }
+
+                node_blocks_.push_back(_node_pool._blocks[node_._block_index]);
+                const auto block_ = static_cast<uint32_t>(node_blocks_.size()) - 1;
+                node_of_()._block_index = block_;
+
+                // reversed so the lowest child is popped, and laid out, first
+                for(uint8_t pending_ = node_._mask; pending_ != 0; pending_ &= static_cast<uint8_t>(~(0x80u >> std::countl_zero(pending_)))) {
+                    stack_.push_back({block_, 7u - std::countl_zero(pending_), frame_._depth + 1}); }
+            }
+
+            _node_pool.assign_compacted(std::move(node_blocks_));
+            _voxel_pool.assign_compacted(std::move(voxel_blocks_));
+
+            if constexpr (DETAILS._aggregate) {
+                refresh_aggregates(); }
+        }
+
+        ////////////////////////
+        // folds every fully occupied subtree whose voxels all hold the same value into one node that 
+        // keeps the value, get() stops at that node and returns the shared value (writing through it 
+        // changes the whole subtree), alloc() / dealloc() expand it again one level per step on the 
+        // way down, the root is never collapsed and voxel pointers handed out before are invalidated
+        ////////////////////////
+        void collapse_uniform()
+        {
+            static_assert(DETAILS._collapse_uniform, "collapse_uniform() needs details_info::_collapse_uniform");
+            collapse_impl(_root_node, 0);
+        }
+
+        ////////////////////////
+        // the aggregate of the node at depth level containing the voxel, without descending any 
+        // further, level 0 is the root and a node at level covers (AXIS_WIDTH >> level)^3 voxels 
+        // down to 2^3 at MAX_DEPTH-1, nullptr when no voxel lies in that node
+        ////////////////////////
+        const aggregate_type* get_lod(const vector_type& voxel_position, uint32_t level)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_lod_impl(voxel_morton, level);
+        }
+
+        const aggregate_type* get_lod(morton_type voxel_morton, uint32_t level)
+        {
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_lod_impl(voxel_morton, level);
+        }
+
+        // reduces every aggregate again, voxels changed through pointers from get() are not seen before
+        void refresh_aggregates()
+        {
+            static_assert(DETAILS._aggregate, "refresh_aggregates() needs details_info::_aggregate");
+            // sized to the pool again, compact() shrinks it
+            _aggregates._blocks.assign(_node_pool._blocks.size(), {});
+            _aggregates._root = refresh_aggregates_impl(_root_node, 0);
+        }
+
+        ////////////////////////
+        // reports what changed since the last call as callback(const vector_type& region_min, uint32_t region_extent) 
+        // and forgets it, a region is a node at region_depth (AXIS_WIDTH >> region_depth wide) with a changed 
+        // voxel below, a subtree removed above region_depth is reported whole at the depth it was removed at
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void consume_dirty(CALLBACK_T&& callback, uint32_t region_depth = MAX_DEPTH-1)
+        {
+            static_assert(DETAILS._track_dirty, "consume_dirty() needs details_info::_track_dirty");
+            assert(region_depth >= 1 && region_depth <= MAX_DEPTH);
+
+            std::array<dirty_frame, MAX_DEPTH> stack_{};
+            stack_[0] = {&_root_node, 0, std::exchange(_root_node._dirty, 0), false};
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                dirty_frame& frame_ = stack_[depth_];
+                if(frame_._pending == 0) 
+                {
+                    if(depth_ == 0) {
+                        return; }
+                    --depth_;
+                    continue;
+                }
+
+                const auto index = static_cast<uint32_t>(std::countr_zero(frame_._pending));
+                frame_._pending &= static_cast<uint8_t>(frame_._pending - 1);
+                const auto morton_ = static_cast<morton_type>((frame_._morton << 3) | index);
+                const bool exist_ = (frame_._node->_mask >> index) & 1u;
+
+                // removed and collapsed subtrees are reported whole
+                bool whole_ = !exist_;
+                if constexpr (DETAILS._collapse_uniform) {
+                    whole_ = whole_ || (depth_+1 < MAX_DEPTH && _node_pool._blocks[frame_._node->_block_index][index]._uniform); }
+
+                // below a reported region the walk only clears
+                bool reported_ = frame_._reported;
+                if(!reported_ && (depth_+1 == region_depth || whole_))
+                {
+                    vector_type region_min_{};
+                    morton_util<BIT_WIDTH>::morton_to_pos(static_cast<morton_type>(morton_ << (3 * (MAX_DEPTH-1 - depth_))), &region_min_[0]);
+                    callback(static_cast<const vector_type&>(region_min_), AXIS_WIDTH >> (depth_+1));
+                    reported_ = true;
+                }
+
+                // voxels carry no dirty bits
+                if(whole_ || depth_+1 == MAX_DEPTH) {
+                    continue; }
+
+                node_format* child_ = &_node_pool._blocks[frame_._node->_block_index][index];
+                stack_[depth_+1] = {child_, morton_, std::exchange(child_->_dirty, 0), reported_};
+                ++depth_;
+            }
+        }
+
+        // whether consume_dirty() has anything to report
+        [[nodiscard]] 
+        bool has_dirty() const
+        {
+            static_assert(DETAILS._track_dirty, "has_dirty() needs details_info::_track_dirty");
+            return _root_node._dirty != 0;
+        }
+
+        // flags an existing voxel edited in place through get(), returns false if there is no voxel
+        bool mark_dirty(const vector_type& voxel_position)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return mark_dirty(voxel_morton);
+        }
+
+        bool mark_dirty(morton_type voxel_morton)
+        {
+            static_assert(DETAILS._track_dirty, "mark_dirty() needs details_info::_track_dirty");
+
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            if constexpr (DETAILS._collapse_uniform) {
+                expand_path(voxel_morton, nullptr); }
+
+            [[maybe_unused]] const auto lock_ = lock_octant(voxel_morton);
+            uint8_t depth_ = 0;
+            std::array<node_format*, MAX_DEPTH> path_{};
+            std::array<uint8_t, MAX_DEPTH> child_bits{};
+            if(!get_traced_impl(voxel_morton, &path_[0], &child_bits[0], &depth_)) {
+                return false; }
+
+            for(uint32_t i = 0; i <= depth_; ++i) {
+                set_dirty_bits(*path_[i], child_bits[i]); }
+            return true;
+        }
+
+        voxel_format* get_traced(const vector_type& voxel_position, node_format** node_path, uint8_t* child_bits, uint8_t* reached_depth)
+        {
+            static_assert(!DETAILS._collapse_uniform, "get_traced() does not descend into collapsed subtrees");
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_traced_impl(voxel_morton, node_path, child_bits, reached_depth);
+        }
+
+        voxel_format* get_traced(morton_type voxel_morton, node_format** node_path, uint8_t* child_bits, uint8_t* reached_depth)
+        {
+            static_assert(!DETAILS._collapse_uniform, "get_traced() does not descend into collapsed subtrees");
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_traced_impl(voxel_morton, node_path, child_bits, reached_depth);
+        }
+
+        struct raycast_hit
+        {
+            // nullptr when nothing was hit within max distance
+            voxel_format* 
+            _voxel{};
+
+            vector_type 
+            _position{};
+
+            voxel_face 
+            _face{face_none};
+
+            float 
+            _distance{};
+        };
+
+        ////////////////////////
+        // first voxel along the ray, parametric octree traversal (Revelles et al.) visiting 
+        // children front to back, a clear mask bit skips the whole child subtree, origin is in 
+        // voxel units with voxel p spanning [p, p + 1) and direction does not need to be normalized
+        ////////////////////////
+        [[nodiscard]] 
+        raycast_hit raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance)
+        {
+            static_assert(!DETAILS._collapse_uniform, "raycast() does not descend into collapsed subtrees");
+            raycast_hit hit_{};
+
+            const float length_ = glm::length(direction);
+            if(!(length_ > 0.0f)) {
+                return hit_; }
+
+            // mirror the ray into the all-positive octant, child c of the mirrored walk is 
+            // child c ^ flip_ of the tree and the visiting order only depends on the entry plane
+            glm::vec3 origin_ = origin;
+            glm::vec3 inv_direction_{};
+            uint32_t flip_ = 0;
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                float direction_ = direction[axis_] / length_;
+                if(direction_ < 0.0f) {
+                    origin_[axis_] = static_cast<float>(AXIS_WIDTH) - origin_[axis_];
+                    direction_ = -direction_;
+                    flip_ |= 1u << axis_;
+                }
+                // axis parallel rays get a tiny slope, keeps the slab math clear of 0 * inf
+                inv_direction_[axis_] = 1.0f / std::max(direction_, RAY_MIN_DIRECTION);
+            }
+
+            const glm::vec3 t0_ = (glm::vec3(0.0f) - origin_) * inv_direction_;
+            const glm::vec3 t1_ = (glm::vec3(static_cast<float>(AXIS_WIDTH)) - origin_) * inv_direction_;
+            const float entry_ = max3(t0_);
+            const float exit_  = min3(t1_);
+            if(entry_ >= exit_ || exit_ < 0.0f || entry_ > max_distance) {
+                return hit_; }
+
+            std::array<raycast_frame, MAX_DEPTH> stack_{};
+            {
+                const glm::vec3 tm_ = (t0_ + t1_) * 0.5f;
+                stack_[0] = {&_root_node, t0_, t1_, tm_, 0, first_child(t0_, tm_)};
+            }
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                raycast_frame& frame_ = stack_[depth_];
+                if(frame_._child > 7) 
+                {
+                    if(depth_ == 0) {
+                        return hit_; }
+                    --depth_;
+                    continue;
+                }
+
+                const uint32_t child_ = frame_._child;
+                glm::vec3 child_t0_{};
+                glm::vec3 child_t1_{};
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    const bool upper_ = (child_ >> axis_) & 1u;
+                    child_t0_[axis_] = upper_ ? frame_._tm[axis_] : frame_._t0[axis_];
+                    child_t1_[axis_] = upper_ ? frame_._t1[axis_] : frame_._tm[axis_];
+                }
+                frame_._child = next_child(child_, child_t1_);
+
+                // behind the origin
+                if(min3(child_t1_) < 0.0f) {
+                    continue; }
+
+                // children are visited in entry order, nothing later can be closer
+                const float child_entry_ = max3(child_t0_);
+                if(child_entry_ > max_distance) {
+                    return hit_; }
+
+                const uint32_t index = child_ ^ flip_;
+                if(((frame_._node->_mask >> index) & 1u) == 0) {
+                    continue; }
+
+                const auto morton_ = static_cast<morton_type>((frame_._morton << 3) | index);
+
+                ////////////////////////
+                //        VOXEL       //
+                ////////////////////////
+                if(depth_ == MAX_DEPTH-1)
+                {
+                    hit_._voxel = &_voxel_pool._blocks[frame_._node->_block_index][index];
+                    morton_util<BIT_WIDTH>::morton_to_pos(morton_, &hit_._position[0]);
+                    hit_._distance = std::max(child_entry_, 0.0f);
+                    hit_._face = child_entry_ > 0.0f ? entry_face(child_t0_, flip_) : face_none;
+                    return hit_;
+                }
+
+                const glm::vec3 child_tm_ = (child_t0_ + child_t1_) * 0.5f;
+                stack_[depth_+1] = {
+                    &_node_pool._blocks[frame_._node->_block_index][index], 
+                    child_t0_, child_t1_, child_tm_, morton_, 
+                    first_child(child_t0_, child_tm_)};
+                ++depth_;
+            }
+        }
+
+        // rays are traced one after another, hits[i] receives the result of rays[i]
+        void raycast_bulk(const ray* rays, raycast_hit* hits, size_t count)
+        {
+            for(size_t i = 0; i < count; ++i) {
+                hits[i] = raycast(rays[i]._origin, rays[i]._direction, rays[i]._max_distance);
+            }
+        }
+
+        ////////////////////////
+        // the 3x3x3 block around a voxel, out[(dx+1) + 3*(dy+1) + 9*(dz+1)] for dx, dy, dz in {-1, 0, 1}, 
+        // neighbours outside the bounds or not allocated are nullptr, the 8 deepest level nodes 
+        // covering the block are resolved once instead of walking the tree once per neighbour
+        ////////////////////////
+        inline static constexpr uint32_t 
+        NEIGHBORHOOD_SIZE = 27;
+
+        void get_neighborhood(const vector_type& voxel_position, voxel_format** out)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { std::fill_n(out, NEIGHBORHOOD_SIZE, nullptr); return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            get_neighborhood_impl(voxel_position, out);
+        }
+
+        void get_neighborhood(morton_type voxel_morton, voxel_format** out)
+        {
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { std::fill_n(out, NEIGHBORHOOD_SIZE, nullptr); return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            vector_type voxel_position{};
+            morton_util<BIT_WIDTH>::morton_to_pos(voxel_morton, &voxel_position[0]);
+            get_neighborhood_impl(voxel_position, out);
+        }
+
+        ////////////////////////
+        // the 6 face neighbours of a voxel in order -x, +x, -y, +y, -z, +z, same rules as get_neighborhood
+        ////////////////////////
+        inline static constexpr uint32_t 
+        FACE_NEIGHBORHOOD_SIZE = 6;
+
+        void get_face_neighborhood(const vector_type& voxel_position, voxel_format** out)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { std::fill_n(out, FACE_NEIGHBORHOOD_SIZE, nullptr); return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            get_face_neighborhood_impl(voxel_morton, out);
+        }
+
+        void get_face_neighborhood(morton_type voxel_morton, voxel_format** out)
+        {
+            const bool overflow = is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { std::fill_n(out, FACE_NEIGHBORHOOD_SIZE, nullptr); return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            get_face_neighborhood_impl(voxel_morton, out);
+        }
+
+        ////////////////////////
+        // visits every voxel in ascending morton order as callback(morton_type morton, voxel_format& voxel), 
+        // depth-first over occupied children only with a fixed MAX_DEPTH stack
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void for_each_voxel_morton(CALLBACK_T&& callback)
+        {
+            std::array<iterate_frame, MAX_DEPTH> stack_{};
+            stack_[0] = {&_root_node, 0, _root_node._mask};
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                iterate_frame& frame_ = stack_[depth_];
+                if(frame_._pending == 0) 
+                {
+                    if(depth_ == 0) {
+                        return; }
+                    --depth_;
+                    continue;
+                }
+
+                const auto index = static_cast<uint32_t>(std::countr_zero(frame_._pending));
+                frame_._pending &= static_cast<uint8_t>(frame_._pending - 1);
+                const auto morton_ = static_cast<morton_type>((frame_._morton << 3) | index);
+
+                ////////////////////////
+                //        VOXEL       //
+                ////////////////////////
+                if(depth_ == MAX_DEPTH-1)
+                {
+                    callback(morton_, _voxel_pool._blocks[frame_._node->_block_index][index]);
+                    continue;
+                }
+
+                const node_format* child_ = &_node_pool._blocks[frame_._node->_block_index][index];
+
+                // every voxel of the subtree, all sharing the one value
+                if constexpr (DETAILS._collapse_uniform) {
+                    if(child_->_uniform) 
+                    {
+                        voxel_format& value_ = _voxel_pool._blocks[child_->_block_index][0];
+                        const uint32_t levels_ = MAX_DEPTH - (depth_+1);
+                        const auto first_ = static_cast<morton_type>(morton_ << (3 * levels_));
+                        const auto count_ = static_cast<morton_type>(morton_type{1} << (3 * levels_));
+                        for(morton_type i = 0; i < count_; ++i) {
+                            callback(static_cast<morton_type>(first_ + i), value_); }
+                        continue;
+                    }
+                }
+
+                stack_[depth_+1] = {child_, morton_, child_->_mask};
+                ++depth_;
+            }
+        }
+
+        // same as for_each_voxel_morton with the position decoded, callback(const vector_type& position, voxel_format& voxel)
+        template<typename CALLBACK_T>
+        void for_each_voxel(CALLBACK_T&& callback)
+        {
+            for_each_voxel_morton([&callback](morton_type voxel_morton, voxel_format& voxel) {
+                vector_type position_{};
+                morton_util<BIT_WIDTH>::morton_to_pos(voxel_morton, &position_[0]);
+                callback(static_cast<const vector_type&>(position_), voxel);
+            });
+        }
+
+        ////////////////////////
+        // visits every voxel inside the inclusive box [box_min, box_max] in morton order as 
+        // callback(const vector_type& position, voxel_format& voxel), subtrees outside the box 
+        // are never entered and subtrees fully inside it are walked without bound tests
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void for_each_in_box(const vector_type& box_min, const vector_type& box_max, CALLBACK_T&& callback)
+        {
+            static_assert(!DETAILS._collapse_uniform, "for_each_in_box() does not descend into collapsed subtrees");
+            std::array<uint32_t, 3> min_{};
+            std::array<uint32_t, 3> max_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) 
+            {
+                if(box_min[axis_] > box_max[axis_] || box_min[axis_] >= AXIS_WIDTH) {
+                    return; }
+                min_[axis_] = box_min[axis_];
+                max_[axis_] = util::min<uint32_t>(box_max[axis_], AXIS_WIDTH - 1);
+            }
+
+            std::array<box_frame, MAX_DEPTH> stack_{};
+            {
+                const std::array<uint32_t, 3> origin_{};
+                const bool inside_ = box_contains(origin_, AXIS_WIDTH, min_, max_);
+                stack_[0] = {&_root_node, origin_, 
+                    inside_ ? _root_node._mask : box_children(_root_node._mask, origin_, AXIS_WIDTH / 2, min_, max_), inside_};
+            }
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                box_frame& frame_ = stack_[depth_];
+                if(frame_._pending == 0) 
+                {
+                    if(depth_ == 0) {
+                        return; }
+                    --depth_;
+                    continue;
+                }
+
+                const auto index = static_cast<uint32_t>(std::countr_zero(frame_._pending));
+                frame_._pending &= static_cast<uint8_t>(frame_._pending - 1);
+
+                const uint32_t child_size_ = AXIS_WIDTH >> (depth_ + 1);
+                const std::array<uint32_t, 3> origin_{
+                    frame_._origin[0] + ((index & 1u) ? child_size_ : 0),
+                    frame_._origin[1] + ((index & 2u) ? child_size_ : 0),
+                    frame_._origin[2] + ((index & 4u) ? child_size_ : 0)};
+
+                ////////////////////////
+                //        VOXEL       //
+                ////////////////////////
+                if(depth_ == MAX_DEPTH-1)
+                {
+                    const vector_type position_(origin_[0], origin_[1], origin_[2]);
+                    callback(position_, _voxel_pool._blocks[frame_._node->_block_index][index]);
+                    continue;
+                }
+
+                const node_format* child_ = &_node_pool._blocks[frame_._node->_block_index][index];
+                const bool inside_ = frame_._inside || box_contains(origin_, child_size_, min_, max_);
+                stack_[depth_+1] = {child_, origin_, 
+                    inside_ ? child_->_mask : box_children(child_->_mask, origin_, child_size_ / 2, min_, max_), inside_};
+                ++depth_;
+            }
+        }
+
+        ////////////////////////
+        // voxel pairs where body b, translated by offset into the space of body a, overlaps body a, 
+        // both trees are descended together and a pair of nodes is only expanded into the child 
+        // pairs whose extents intersect and whose mask bits are set on both sides, so the cost 
+        // follows the contact region instead of the body volume, reported as
+        // callback(const vector_type& position_a, voxel_format& voxel_a, voxel_format& voxel_b) -> bool, 
+        // returning false stops the search
+        ////////////////////////
+        template<typename CALLBACK_T>
+        static void for_each_overlap(tree& a, tree& b, const glm::ivec3& offset, CALLBACK_T&& callback)
+        {
+            static_assert(!DETAILS._collapse_uniform, "for_each_overlap() does not descend into collapsed subtrees");
+            const std::array<int32_t, 3> offset_{offset[0], offset[1], offset[2]};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                if(offset_[axis_] >= static_cast<int32_t>(AXIS_WIDTH) || -offset_[axis_] >= static_cast<int32_t>(AXIS_WIDTH)) {
+                    return; }
+            }
+
+            // each expanded pair pushes at most 8x8 children, one expansion per level is live at a time
+            std::array<overlap_frame, 64 * MAX_DEPTH> stack_{};
+            uint32_t size_ = 0;
+            stack_[size_++] = {&a._root_node, &b._root_node, {0, 0, 0}, offset_, 0};
+
+            while(size_ > 0)
+            {
+                const overlap_frame frame_ = stack_[--size_];
+                const int32_t child_size_ = static_cast<int32_t>(AXIS_WIDTH >> (frame_._depth + 1));
+
+                // per axis, which halves of b intersect the lower / upper half of a
+                std::array<std::array<uint8_t, 2>, 3> allowed_{};
+                constexpr std::array<uint8_t, 3> LOWER = {0x55, 0x33, 0x0F};
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    for(uint32_t half_a_ = 0; half_a_ < 2; ++half_a_) 
+                    {
+                        const int32_t begin_a_ = frame_._origin_a[axis_] + static_cast<int32_t>(half_a_) * child_size_;
+                        uint8_t mask_ = 0;
+                        for(uint32_t half_b_ = 0; half_b_ < 2; ++half_b_) {
+                            const int32_t begin_b_ = frame_._origin_b[axis_] + static_cast<int32_t>(half_b_) * child_size_;
+                            if(begin_a_ < begin_b_ + child_size_ && begin_b_ < begin_a_ + child_size_) {
+                                mask_ |= half_b_ ? static_cast<uint8_t>(~LOWER[axis_]) : LOWER[axis_]; }
+                        }
+                        allowed_[axis_][half_a_] = mask_;
+                    }
+                }
+
+                for(uint8_t mask_a_ = frame_._a->_mask; mask_a_ != 0; mask_a_ &= static_cast<uint8_t>(mask_a_ - 1))
+                {
+                    const auto index_a_ = static_cast<uint32_t>(std::countr_zero(mask_a_));
+                    uint8_t mask_b_ = static_cast<uint8_t>(frame_._b->_mask & 
+                        allowed_[0][index_a_ & 1u] & allowed_[1][(index_a_ >> 1) & 1u] & allowed_[2][index_a_ >> 2]);
+
+                    const std::array<int32_t, 3> origin_a_{
+                        frame_._origin_a[0] + ((index_a_ & 1u) ? child_size_ : 0),
+                        frame_._origin_a[1] + ((index_a_ & 2u) ? child_size_ : 0),
+                        frame_._origin_a[2] + ((index_a_ & 4u) ? child_size_ : 0)};
+
+                    for(; mask_b_ != 0; mask_b_ &= static_cast<uint8_t>(mask_b_ - 1))
+                    {
+                        const auto index_b_ = static_cast<uint32_t>(std::countr_zero(mask_b_));
+
+                        ////////////////////////
+                        //        VOXEL       //
+                        ////////////////////////
+                        if(frame_._depth == MAX_DEPTH-1)
+                        {
+                            const vector_type position_(origin_a_[0], origin_a_[1], origin_a_[2]);
+                            if(!callback(position_, 
+                                a._voxel_pool._blocks[frame_._a->_block_index][index_a_], 
+                                b._voxel_pool._blocks[frame_._b->_block_index][index_b_])) {
+                                return; }
+                            continue;
+                        }
+
+                        const std::array<int32_t, 3> origin_b_{
+                            frame_._origin_b[0] + ((index_b_ & 1u) ? child_size_ : 0),
+                            frame_._origin_b[1] + ((index_b_ & 2u) ? child_size_ : 0),
+                            frame_._origin_b[2] + ((index_b_ & 4u) ? child_size_ : 0)};
+
+                        stack_[size_++] = {
+                            &a._node_pool._blocks[frame_._a->_block_index][index_a_], 
+                            &b._node_pool._blocks[frame_._b->_block_index][index_b_], 
+                            origin_a_, origin_b_, frame_._depth + 1};
+                    }
+                }
+            }
+        }
+
+        // whether body b translated by offset touches any voxel of body a
+        [[nodiscard]] 
+        static bool overlaps(tree& a, tree& b, const glm::ivec3& offset)
+        {
+            bool overlap_ = false;
+            for_each_overlap(a, b, offset, [&overlap_](const vector_type&, voxel_format&, voxel_format&) {
+                overlap_ = true;
+                return false;
+            });
+            return overlap_;
+        }
+
+        ////////////////////////
+        // TREE CSG
+        // combines body b, translated by offset into the space of this tree, into this tree: unite() 
+        // adds its voxels, intersect() keeps only the voxels it covers and subtract() removes the 
+        // voxels it covers, merge decides the payload where both hold a voxel, both hierarchies are 
+        // walked together and each node is matched with the up to 8 nodes of b its extent straddles 
+        // (one when offset is a multiple of the node size), so regions empty in b are skipped 
+        // (or released whole by intersect()) and subtrees of b landing where this tree is empty are 
+        // copied block by block, the cost follows the overlapping structure instead of the voxel count, 
+        // voxels of b falling outside BOUNDS are dropped and voxel pointers handed out before are invalidated
+        ////////////////////////
+        template<typename MERGE_T = take_source_voxel>
+        void unite(const tree& b, const glm::ivec3& offset, MERGE_T&& merge = MERGE_T{})
+        {
+            csg<csg_op::unite>(b, offset, merge);
+        }
+
+        template<typename MERGE_T = keep_target_voxel>
+        void intersect(const tree& b, const glm::ivec3& offset, MERGE_T&& merge = MERGE_T{})
+        {
+            csg<csg_op::intersect>(b, offset, merge);
+        }
+
+        void subtract(const tree& b, const glm::ivec3& offset)
+        {
+            keep_target_voxel merge_{};
+            csg<csg_op::subtract>(b, offset, merge_);
+        }
+
+        // the CSG operations into a new tree, a copy of a combined with b
+        template<typename MERGE_T = take_source_voxel>
+        [[nodiscard]] 
+        static tree tree_union(const tree& a, const tree& b, const glm::ivec3& offset, MERGE_T&& merge = MERGE_T{})
+        {
+            tree result_ = a;
+            result_.unite(b, offset, merge);
+            return result_;
+        }
+
+        template<typename MERGE_T = keep_target_voxel>
+        [[nodiscard]] 
+        static tree tree_intersect(const tree& a, const tree& b, const glm::ivec3& offset, MERGE_T&& merge = MERGE_T{})
+        {
+            tree result_ = a;
+            result_.intersect(b, offset, merge);
+            return result_;
+        }
+
+        [[nodiscard]] 
+        static tree tree_subtract(const tree& a, const tree& b, const glm::ivec3& offset)
+        {
+            tree result_ = a;
+            result_.subtract(b, offset);
+            return result_;
+        }
+
+        ////////////////////////
+        // CONNECTED COMPONENTS
+        // groups the voxels into components connected through shared faces (connect_faces) or through 
+        // shared faces, edges and corners (connect_all) and reports every voxel as 
+        // callback(const vector_type& position, voxel_format& voxel, uint32_t component) with the 
+        // components numbered from 0 in the order they are first reached, returns the component count, 
+        // fully occupied subtrees are taken whole and the faces, edges and corners between nodes 
+        // are walked down the hierarchy only where partly occupied nodes meet, so per voxel work 
+        // is left to the voxel blocks along those seams, the scratch space follows the pool sizes
+        ////////////////////////
+        template<typename CALLBACK_T>
+        uint32_t find_components(CALLBACK_T&& callback, voxel_connectivity connectivity = connect_faces)
+        {
+            const vector_type min_(0, 0, 0);
+            const vector_type max_(BOUNDS[0] - 1, BOUNDS[1] - 1, BOUNDS[2] - 1);
+            return connectivity == connect_all ? 
+                components<connect_all, false>(min_, max_, nullptr, 0, callback) : 
+                components<connect_faces, false>(min_, max_, nullptr, 0, callback);
+        }
+
+        // same as find_components() reporting only the voxels of components that hold none of 
+        // the anchors, those numbered from 0, anchor positions without a voxel are ignored
+        template<typename CALLBACK_T>
+        uint32_t find_detached_from(const vector_type* anchors, size_t anchor_count, CALLBACK_T&& callback, 
+            voxel_connectivity connectivity = connect_faces)
+        {
+            const vector_type min_(0, 0, 0);
+            const vector_type max_(BOUNDS[0] - 1, BOUNDS[1] - 1, BOUNDS[2] - 1);
+            return connectivity == connect_all ? 
+                components<connect_all, true>(min_, max_, anchors, anchor_count, callback) : 
+                components<connect_faces, true>(min_, max_, anchors, anchor_count, callback);
+        }
+
+        // same as find_detached_from() over the voxels inside the inclusive box [box_min, box_max] 
+        // only, such as a region around the last edit, components reaching a box face that lies 
+        // inside the tree may go on beyond it and count as anchored
+        template<typename CALLBACK_T>
+        uint32_t find_detached_in_box(const vector_type& box_min, const vector_type& box_max, 
+            const vector_type* anchors, size_t anchor_count, CALLBACK_T&& callback, voxel_connectivity connectivity = connect_faces)
+        {
+            return connectivity == connect_all ? 
+                components<connect_all, true>(box_min, box_max, anchors, anchor_count, callback) : 
+                components<connect_faces, true>(box_min, box_max, anchors, anchor_count, callback);
+        }
+
+        ////////////////////////
+        // breadth-first linearised read-only copy, nodes keep only their child mask and the 
+        // index of their first child in 4 bytes, empty child slots and voxel slots are not 
+        // stored, up to 2^24 nodes and voxels (frozen_node_format)
+        ////////////////////////
+        [[nodiscard]] 
+        frozen_tree<tree> freeze() const
+        {
+            static_assert(!DETAILS._collapse_uniform, "freeze() does not descend into collapsed subtrees");
+            frozen_tree<tree> frozen_{};
+            frozen_._nodes.reserve(get_node_blocks_count() * 8 + 1);
+            frozen_._voxels.reserve(get_voxel_blocks_count() * 8);
+
+            std::vector<const node_format*> level_{ &_root_node };
+            std::vector<const node_format*> next_level_{};
+            frozen_._nodes.push_back({0, _root_node._mask});
+
+            uint32_t level_begin_ = 0;
+            for(uint32_t depth_ = 0; depth_ < MAX_DEPTH-1; ++depth_)
+            {
+                next_level_.clear();
+                const auto next_level_begin_ = static_cast<uint32_t>(frozen_._nodes.size());
+
+                for(uint32_t i = 0; i < level_.size(); ++i)
+                {
+                    const node_format* node_ = level_[i];
+                    const auto& node_block_ = _node_pool._blocks[node_->_block_index];
+                    frozen_._nodes[level_begin_ + i].set_first_child(static_cast<uint32_t>(frozen_._nodes.size()));
+
+                    for(uint8_t mask_ = node_->_mask; mask_ != 0; mask_ &= mask_ - 1)
+                    {
+                        const auto& child_ = node_block_[std::countr_zero(mask_)];
+                        frozen_._nodes.push_back({0, child_._mask});
+                        next_level_.push_back(&child_);
+                    }
+                }
+
+                level_.swap(next_level_);
+                level_begin_ = next_level_begin_;
+            }
+
+            ////////////////////////
+            //       VOXELS       //
+            ////////////////////////
+            for(uint32_t i = 0; i < level_.size(); ++i)
+            {
+                const node_format* node_ = level_[i];
+                const auto& voxel_block_ = _voxel_pool._blocks[node_->_block_index];
+                frozen_._nodes[level_begin_ + i].set_first_child(static_cast<uint32_t>(frozen_._voxels.size()));
+
+                for(uint8_t mask_ = node_->_mask; mask_ != 0; mask_ &= mask_ - 1) {
+                    frozen_._voxels.push_back(voxel_block_[std::countr_zero(mask_)]);
+                }
+            }
+
+            return frozen_;
+        }
+
+        ////////////////////////
+        // read-only copy with every set of equal subtrees stored once, see dag_tree
+        ////////////////////////
+        [[nodiscard]] 
+        dag_tree<tree> to_dag() const
+        {
+            dag_tree<tree> dag_{};
+            to_dag(dag_);
+            return dag_;
+        }
+
+        // merges the tree into dag as a further root sharing the subtrees already there, returns the root
+        uint32_t to_dag(dag_tree<tree>& dag) const
+        {
+            static_assert(!DETAILS._collapse_uniform, "to_dag() does not descend into collapsed subtrees");
+            static_assert(std::equality_comparable<voxel_format>, "to_dag() merges voxels that compare equal");
+            dag._roots.push_back(dag_record(_root_node, 0, dag));
+            return static_cast<uint32_t>(dag._roots.size()) - 1;
+        }
+
+        ////////////////////////
+        // writes a snapshot_header file that tree_view can map, block indices are compacted so
+        // free list holes are not written, returns false if the file could not be written
+        ////////////////////////
+        [[nodiscard]] 
+        bool save(const char* path) const
+        {
+            static_assert(!DETAILS._collapse_uniform, "save() does not descend into collapsed subtrees");
+            static_assert(std::endian::native == std::endian::little, "snapshots are little-endian");
+            static_assert(std::is_trivially_copyable_v<voxel_format>, "snapshots copy voxels bytewise");
+
+            ////////////////////////
+            //  COMPACT, PREORDER //
+            ////////////////////////
+            struct frame { const node_format* _node; uint32_t _slot; uint32_t _depth; };
+
+            constexpr uint32_t ROOT_SLOT = ~0u;
+
+            std::vector<snapshot_node_format> nodes_{};
+            std::vector<const node_format*> voxel_owners_{};
+            std::vector<frame> stack_{ {&_root_node, ROOT_SLOT, 0} };
+
+            while(!stack_.empty())
+            {
+                const frame frame_ = stack_.back();
+                stack_.pop_back();
+
+                const node_format* node_ = frame_._node;
+                if(frame_._depth == MAX_DEPTH-1) 
+                {
+                    nodes_[frame_._slot]._block_index = static_cast<uint32_t>(voxel_owners_.size());
+                    voxel_owners_.push_back(node_);
+                    continue;
+                }
+
+                const auto block_ = static_cast<uint32_t>(nodes_.size() / 8);
+                nodes_.resize(nodes_.size() + 8);
+                if(frame_._slot != ROOT_SLOT) {
+                    nodes_[frame_._slot]._block_index = block_; }
+
+                const auto& node_block_ = _node_pool._blocks[node_->_block_index];
+                // reversed so the lowest child is popped, and laid out, first
+                for(uint8_t mask_ = node_->_mask; mask_ != 0; mask_ &= static_cast<uint8_t>(~(0x80u >> std::countl_zero(mask_))))
+                {
+                    const uint32_t index_ = 7 - std::countl_zero(mask_);
+                    const node_format& child_ = node_block_[index_];
+                    const uint32_t slot_ = block_ * 8 + index_;
+
+                    nodes_[slot_]._depth = static_cast<uint8_t>(frame_._depth + 1);
+                    nodes_[slot_]._mask  = child_._mask;
+                    // a child without children of its own keeps block 0, its mask is never passed
+                    if(child_._mask != 0) {
+                        stack_.push_back({&child_, slot_, frame_._depth + 1}); }
+                }
+            }
+
+            ////////////////////////
+            //        WRITE       //
+            ////////////////////////
+            snapshot_header header_{};
+            header_._magic        = snapshot_header::MAGIC;
+            header_._version      = snapshot_header::VERSION;
+            header_._bit_width    = static_cast<uint32_t>(BIT_WIDTH);
+            header_._max_depth    = MAX_DEPTH;
+            header_._voxel_size   = sizeof(voxel_format);
+            header_._bounds       = BOUNDS;
+            header_._node_blocks  = static_cast<uint32_t>(nodes_.size() / 8);
+            header_._voxel_blocks = static_cast<uint32_t>(voxel_owners_.size());
+            header_._root_mask    = _root_node._mask;
+            header_._node_offset  = sizeof(snapshot_header);
+            header_._voxel_offset = util::align_up<uint64_t>(header_._node_offset + nodes_.size() * sizeof(snapshot_node_format), 64);
+
+            std::FILE* file_ = std::fopen(path, "wb");
+            if(file_ == nullptr) {
+                return false; }
+
+            bool ok_ = std::fwrite(&header_, sizeof(header_), 1, file_) == 1;
+            ok_ = ok_ && std::fwrite(nodes_.data(), sizeof(snapshot_node_format), nodes_.size(), file_) == nodes_.size();
+
+            const std::array<uint8_t, 64> padding_{};
+            const auto padding_size_ = static_cast<size_t>(header_._voxel_offset - header_._node_offset - nodes_.size() * sizeof(snapshot_node_format));
+            ok_ = ok_ && std::fwrite(padding_.data(), 1, padding_size_, file_) == padding_size_;
+
+            // absent slots are written default constructed
+            std::array<voxel_format, 8> voxel_block_{};
+            for(size_t i = 0; ok_ && i < voxel_owners_.size(); ++i)
+            {
+                const node_format* owner_ = voxel_owners_[i];
+                const auto& source_block_ = _voxel_pool._blocks[owner_->_block_index];
+                for(uint32_t j = 0; j < 8; ++j) {
+                    voxel_block_[j] = (owner_->_mask >> j) & 1u ? source_block_[j] : voxel_format{}; }
+
+                ok_ = std::fwrite(voxel_block_.data(), sizeof(voxel_format), 8, file_) == 8;
+            }
+
+            ok_ = std::fclose(file_) == 0 && ok_;
+            return ok_;
+        }
+
+    private:
+
+        inline static constexpr float
+        RAY_MIN_DIRECTION = 1e-20f;
+
+        struct raycast_frame
+        {
+            const node_format* 
+            _node{};
+
+            glm::vec3 
+            _t0{};
+
+            glm::vec3 
+            _t1{};
+
+            glm::vec3 
+            _tm{};
+
+            morton_type 
+            _morton{};
+
+            // next child to visit in mirrored space, past 7 when done
+            uint32_t 
+            _child{};
+        };
+
+        static float min3(const glm::vec3& v_) { return std::min(std::min(v_[0], v_[1]), v_[2]); }
+
+        static float max3(const glm::vec3& v_) { return std::max(std::max(v_[0], v_[1]), v_[2]); }
+
+        // child the ray enters first, decided by the plane the node is entered through
+        static uint32_t first_child(const glm::vec3& t0_, const glm::vec3& tm_)
+        {
+            if(t0_[0] > t0_[1] && t0_[0] > t0_[2]) {
+                return (tm_[1] < t0_[0] ? 2u : 0u) | (tm_[2] < t0_[0] ? 4u : 0u); }
+            if(t0_[1] > t0_[2]) {
+                return (tm_[0] < t0_[1] ? 1u : 0u) | (tm_[2] < t0_[1] ? 4u : 0u); }
+            return (tm_[0] < t0_[2] ? 1u : 0u) | (tm_[1] < t0_[2] ? 2u : 0u);
+        }
+
+        // sibling the ray moves into when leaving child_ through its nearest exit plane, 8 when 
+        // it leaves the parent instead
+        static uint32_t next_child(uint32_t child_, const glm::vec3& t1_)
+        {
+            const uint32_t axis_ = t1_[0] < t1_[1] ? 
+                (t1_[0] < t1_[2] ? 0u : 2u) : 
+                (t1_[1] < t1_[2] ? 1u : 2u);
+            const uint32_t axis_bit_ = 1u << axis_;
+            return (child_ & axis_bit_) ? 8u : child_ | axis_bit_;
+        }
+
+        static voxel_face entry_face(const glm::vec3& t0_, uint32_t flip_)
+        {
+            const uint32_t axis_ = t0_[0] > t0_[1] ? 
+                (t0_[0] > t0_[2] ? 0u : 2u) : 
+                (t0_[1] > t0_[2] ? 1u : 2u);
+            // a ray travelling towards +axis enters through the voxel's -axis face
+            return static_cast<voxel_face>(face_neg_x + 2 * axis_ + ((flip_ >> axis_) & 1u));
+        }
+
+        enum class csg_op { unite, intersect, subtract };
+
+        // nodes of b at one depth in a 2x2x2 block whose lower corner is _origin in the space of b, 
+        // nullptr where b holds nothing
+        struct csg_cells
+        {
+            std::array<const node_format*, 8> 
+            _nodes{};
+
+            std::array<int32_t, 3> 
+            _origin{};
+        };
+
+        // nodes of b one depth below a csg_cells block in the 3x3x3 block around the children of a node, 
+        // with the octants the children cover on every side of their 2x2x2 cells, none for sides never reached
+        struct csg_grid
+        {
+            std::array<const node_format*, 27> 
+            _nodes{};
+
+            std::array<uint8_t, 8> 
+            _covered{};
+
+            std::array<int32_t, 3> 
+            _origin{};
+
+            int32_t 
+            _size{};
+
+            // bit x + 3*y + 9*z set for every node present in _nodes
+            uint32_t 
+            _occupied{};
+        };
+
+        // a node taking part in a component search, _node is nullptr where nothing of it lies in the box
+        struct component_cell
+        {
+            const node_format* 
+            _node{};
+
+            std::array<uint32_t, 3> 
+            _origin{};
+
+            uint32_t 
+            _depth{};
+        };
+
+        ////////////////////////
+        // component search scratch, the voxels are split into pieces, a fully occupied subtree or 
+        // a face connected part of a voxel block (the whole block with connect_all), and pieces found 
+        // to touch are joined in a union-find over their indices
+        ////////////////////////
+        struct component_search
+        {
+            std::array<uint32_t, 3> 
+            _min{};
+
+            std::array<uint32_t, 3> 
+            _max{};
+
+            // by node block, whether the node owning it is fully occupied, aggregates count it instead
+            std::vector<uint8_t> 
+            _full{};
+
+            // first piece of a leaf, by the child block of fully occupied nodes and by 
+            // the voxel block of voxel blocks and collapsed nodes
+            std::vector<uint32_t> 
+            _node_pieces{};
+
+            std::vector<uint32_t> 
+            _voxel_pieces{};
+
+            // every piece points toward the representative of its component
+            std::vector<uint32_t> 
+            _parents{};
+
+            std::vector<uint8_t> 
+            _anchored{};
+        };
+
+        struct overlap_frame
+        {
+            const node_format* 
+            _a{};
+
+            const node_format* 
+            _b{};
+
+            std::array<int32_t, 3> 
+            _origin_a{};
+
+            // in the space of a
+            std::array<int32_t, 3> 
+            _origin_b{};
+
+            uint32_t 
+            _depth{};
+        };
+
+        struct iterate_frame
+        {
+            const node_format* 
+            _node{};
+
+            morton_type 
+            _morton{};
+
+            // children still to visit
+            uint8_t 
+            _pending{};
+        };
+
+        struct dirty_frame
+        {
+            node_format* 
+            _node{};
+
+            morton_type 
+            _morton{};
+
+            // dirty children still to visit
+            uint8_t 
+            _pending{};
+
+            // an ancestor region was already reported
+            bool 
+            _reported{};
+        };
+
+        struct box_frame
+        {
+            const node_format* 
+            _node{};
+
+            std::array<uint32_t, 3> 
+            _origin{};
+
+            // children still to visit
+            uint8_t 
+            _pending{};
+
+            bool 
+            _inside{};
+        };
+
+        static bool box_contains(const std::array<uint32_t, 3>& origin_, uint32_t size_, 
+            const std::array<uint32_t, 3>& min_, const std::array<uint32_t, 3>& max_)
+        {
+            return 
+                origin_[0] >= min_[0] && origin_[0] + size_ - 1 <= max_[0] &&
+                origin_[1] >= min_[1] && origin_[1] + size_ - 1 <= max_[1] &&
+                origin_[2] >= min_[2] && origin_[2] + size_ - 1 <= max_[2];
+        }
+
+        static std::array<uint32_t, 3> child_origin(const std::array<uint32_t, 3>& origin_, uint32_t child_size_, uint32_t index_)
+        {
+            return {
+                origin_[0] + ((index_ & 1u) ? child_size_ : 0),
+                origin_[1] + ((index_ & 2u) ? child_size_ : 0),
+                origin_[2] + ((index_ & 4u) ? child_size_ : 0)};
+        }
+
+        ////////////////////////
+        // shapes the stamps classify nodes against, contains() holds when the centre of every voxel 
+        // of the cube at origin_ with edge size_ lies in the shape, intersects() when one may
+        ////////////////////////
+        struct box_shape
+        {
+            std::array<uint32_t, 3> 
+            _min{};
+
+            std::array<uint32_t, 3> 
+            _max{};
+
+            bool contains(const std::array<uint32_t, 3>& origin_, uint32_t size_) const
+            {
+                return box_contains(origin_, size_, _min, _max);
+            }
+
+            bool intersects(const std::array<uint32_t, 3>& origin_, uint32_t size_) const
+            {
+                return 
+                    origin_[0] <= _max[0] && origin_[0] + size_ - 1 >= _min[0] &&
+                    origin_[1] <= _max[1] && origin_[1] + size_ - 1 >= _min[1] &&
+                    origin_[2] <= _max[2] && origin_[2] + size_ - 1 >= _min[2];
+            }
+        };
+
+        // the points within _radius of the segment from _a to _a + _ab, a sphere when _ab is zero
+        struct capsule_shape
+        {
+            capsule_shape(const glm::vec3& a_, const glm::vec3& b_, float radius_) : 
+                _a(a_), _ab(b_ - a_), _ab_length2(glm::dot(b_ - a_, b_ - a_)), _radius(radius_) {}
+
+            glm::vec3 
+            _a{};
+
+            glm::vec3 
+            _ab{};
+
+            float 
+            _ab_length2{};
+
+            float 
+            _radius{};
+
+            float axis_distance2(const glm::vec3& point_) const
+            {
+                const float t_ = _ab_length2 > 0.0f ? std::clamp(glm::dot(point_ - _a, _ab) / _ab_length2, 0.0f, 1.0f) : 0.0f;
+                const glm::vec3 offset_ = point_ - (_a + _ab * t_);
+                return glm::dot(offset_, offset_);
+            }
+
+            // the voxel centres of the cube lie within the half diagonal of its middle and the distance 
+            // to the axis changes no faster than the point moves, so one distance bounds the whole cube
+            float reach2(const std::array<uint32_t, 3>& origin_, uint32_t size_, float& half_diagonal_) const
+            {
+                const float half_ = 0.5f * static_cast<float>(size_);
+                half_diagonal_ = 1.7320508f * (half_ - 0.5f);
+                return axis_distance2(glm::vec3(origin_[0] + half_, origin_[1] + half_, origin_[2] + half_));
+            }
+
+            bool contains(const std::array<uint32_t, 3>& origin_, uint32_t size_) const
+            {
+                float half_diagonal_{};
+                const float distance2_ = reach2(origin_, size_, half_diagonal_);
+                const float inner_ = _radius - half_diagonal_;
+                return inner_ >= 0.0f && distance2_ <= inner_ * inner_;
+            }
+
+            bool intersects(const std::array<uint32_t, 3>& origin_, uint32_t size_) const
+            {
+                float half_diagonal_{};
+                const float distance2_ = reach2(origin_, size_, half_diagonal_);
+                const float outer_ = _radius + half_diagonal_;
+                return outer_ >= 0.0f && distance2_ <= outer_ * outer_;
+            }
+        };
+
+        // the box clamped to the tree, false when it holds no voxel of it
+        static bool make_box_shape(const vector_type& box_min, const vector_type& box_max, box_shape& shape_)
+        {
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) 
+            {
+                if(box_min[axis_] > box_max[axis_] || box_min[axis_] >= AXIS_WIDTH) {
+                    return false; }
+                shape_._min[axis_] = box_min[axis_];
+                shape_._max[axis_] = util::min<uint32_t>(box_max[axis_], AXIS_WIDTH - 1);
+            }
+            return true;
+        }
+
+        // the children in mask_ of the node at origin_ that the shape reaches
+        template<typename SHAPE_T>
+        static uint8_t shape_children(uint8_t mask_, const std::array<uint32_t, 3>& origin_, uint32_t child_size_, const SHAPE_T& shape_)
+        {
+            uint8_t hit_ = 0;
+            for(; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(mask_));
+                if(shape_.intersects(child_origin(origin_, child_size_, index_), child_size_)) {
+                    hit_ |= static_cast<uint8_t>(1u << index_); }
+            }
+            return hit_;
+        }
+
+        // fill() writes no voxel past BOUNDS
+        static bool within_bounds(const std::array<uint32_t, 3>& origin_, uint32_t size_)
+        {
+            return origin_[0] + size_ <= BOUNDS[0] && origin_[1] + size_ <= BOUNDS[1] && origin_[2] + size_ <= BOUNDS[2];
+        }
+
+        static bool reaches_bounds(const std::array<uint32_t, 3>& origin_)
+        {
+            return origin_[0] < BOUNDS[0] && origin_[1] < BOUNDS[1] && origin_[2] < BOUNDS[2];
+        }
+
+        // children of a box intersecting node that intersect the box as well, per axis the 
+        // lower and upper half select the child indices with that axis bit clear or set
+        static uint8_t box_children(uint8_t mask_, const std::array<uint32_t, 3>& origin_, uint32_t half_size_, 
+            const std::array<uint32_t, 3>& min_, const std::array<uint32_t, 3>& max_)
+        {
+            constexpr std::array<uint8_t, 3> LOWER = {0x55, 0x33, 0x0F};
+            LOOP_UNROLL
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                const uint32_t mid_ = origin_[axis_] + half_size_;
+                mask_ &= static_cast<uint8_t>(
+                    (min_[axis_] < mid_  ? LOWER[axis_] : 0) | 
+                    (max_[axis_] >= mid_ ? static_cast<uint8_t>(~LOWER[axis_]) : 0));
+            }
+            return mask_;
+        }
+
+        struct partition_build
+        {
+            std::vector<util::sort_entry<morton_type>> 
+            _sorted{};
+
+            bool 
+            _is_sorted = true;
+
+            // built into local pools, no subtree for the partition existed in the tree
+            bool 
+            _local{};
+
+            node_format 
+            _root{};
+
+            mem_pool<node_format> 
+            _node_pool{};
+
+            mem_pool<voxel_format> 
+            _voxel_pool{};
+
+            uint32_t 
+            _node_base{};
+
+            uint32_t 
+            _voxel_base{};
+        };
+
+        // node at PARALLEL_PARTITION_DEPTH whose children share partition_ as morton prefix, nullptr if missing
+        node_format* partition_node(uint32_t partition_)
+        {
+            node_format* node_ = &_root_node;
+            for(uint32_t depth_ = 0; depth_ < PARALLEL_PARTITION_DEPTH; ++depth_)
+            {
+                const uint32_t index = (partition_ >> (3 * (PARALLEL_PARTITION_DEPTH - 1 - depth_))) & 7u;
+                if(((node_->_mask >> index) & 1u) == 0) {
+                    return nullptr; }
+                node_ = &_node_pool._blocks[node_->_block_index][index];
+            }
+            return node_;
+        }
+
+        void mark_partition_dirty(uint32_t partition_)
+        {
+            node_format* node_ = &_root_node;
+            for(uint32_t depth_ = 0; depth_ < PARALLEL_PARTITION_DEPTH; ++depth_)
+            {
+                const uint32_t index = (partition_ >> (3 * (PARALLEL_PARTITION_DEPTH - 1 - depth_))) & 7u;
+                set_dirty_bits(*node_, static_cast<uint8_t>(1u << index));
+                node_ = &_node_pool._blocks[node_->_block_index][index];
+            }
+        }
+
+        // hangs a spliced partition subtree into the tree, creating the nodes above it as needed
+        void link_partition(uint32_t partition_, const node_format& root_)
+        {
+            node_format* node_ = &_root_node;
+            for(uint32_t depth_ = 0; depth_ < PARALLEL_PARTITION_DEPTH; ++depth_)
+            {
+                const uint32_t index = (partition_ >> (3 * (PARALLEL_PARTITION_DEPTH - 1 - depth_))) & 7u;
+                const uint8_t child_bit = static_cast<uint8_t>(1u << index);
+                // read before alloc, the node pool can relocate under node_
+                const uint32_t node_block_index = node_->_block_index;
+                const bool exist = (node_->_mask & child_bit) != 0;
+                node_->_mask |= child_bit;
+                set_dirty_bits(*node_, child_bit);
+
+                if(depth_ == PARALLEL_PARTITION_DEPTH - 1) {
+                    _node_pool._blocks[node_block_index][index] = root_;
+                    return;
+                }
+
+                if(!exist)
+                {
+                    node_format new_node_{};
+                    new_node_._depth = depth_+1;
+                    new_node_._mask  = 0;
+                    new_node_._block_index = _node_pool.alloc();
+                    _node_pool._blocks[node_block_index][index] = new_node_;
+                }
+
+                node_ = &_node_pool._blocks[node_block_index][index];
+            }
+        }
+
+        ////////////////////////
+        // streams entries sorted by voxel block prefix into the subtree of root_ at root_depth_, 
+        // every entry must lie inside that subtree
+        ////////////////////////
+        template<typename NODE_POOL_T, typename VOXEL_POOL_T>
+        static void bulk_build(NODE_POOL_T& node_pool_, VOXEL_POOL_T& voxel_pool_, node_format* root_, uint32_t root_depth_, 
+            const util::sort_entry<morton_type>* sorted_, size_t count_, const spatial_voxel* voxels)
+        {
+            ////////////////////////
+            //  PRE-SIZE  BLOCKS  //
+            ////////////////////////
+            // a node at depth d is distinct from its predecessor's whenever the keys differ 
+            // in more than (MAX_DEPTH - d) low 3-bit groups, exact for an empty subtree and 
+            // an upper bound otherwise
+            std::array<uint32_t, MAX_DEPTH + 1> diff_levels_count_{};
+            for(size_t i = 1; i < count_; ++i) {
+                const auto diff_ = static_cast<morton_type>(sorted_[i]._key ^ sorted_[i-1]._key);
+                ++diff_levels_count_[(static_cast<uint32_t>(std::bit_width(diff_)) + 2) / 3];
+            }
+
+            uint32_t node_blocks_ = 0;
+            uint32_t voxel_blocks_ = 0;
+            uint32_t distinct_ = 1;
+            for(uint32_t depth_ = root_depth_ + 1; depth_ < MAX_DEPTH; ++depth_) 
+            {
+                distinct_ += diff_levels_count_[MAX_DEPTH - depth_ + 1];
+                if(depth_ < MAX_DEPTH-1) {
+                    node_blocks_ += distinct_; 
+                } else {
+                    voxel_blocks_ = distinct_; 
+                }
+            }
+
+            node_pool_.reserve(node_blocks_);
+            voxel_pool_.reserve(voxel_blocks_);
+
+            ////////////////////////
+            //   STREAMING BUILD  //
+            ////////////////////////
+            // blocks are reserved, so node pointers in path_ stay valid for the whole build
+            std::array<node_format*, MAX_DEPTH> path_{};
+            path_[root_depth_] = root_;
+
+            for(size_t i = 0; i < count_; ++i)
+            {
+                const morton_type morton_ = sorted_[i]._key;
+
+                uint32_t depth_ = root_depth_;
+                if(i > 0) {
+                    const auto diff_ = static_cast<morton_type>(morton_ ^ sorted_[i-1]._key);
+                    const uint32_t diff_levels_ = (static_cast<uint32_t>(std::bit_width(diff_)) + 2) / 3;
+                    depth_ = util::min(MAX_DEPTH - diff_levels_, MAX_DEPTH - 1);
+                }
+
+                for(; depth_ < MAX_DEPTH-1; ++depth_)
+                {
+                    node_format* node_ = path_[depth_];
+                    const uint32_t index = static_cast<uint32_t>(morton_ >> (3 * (MAX_DEPTH - 1 - depth_))) & 7u;
+                    const uint8_t child_bit = static_cast<uint8_t>(1u << index);
+                    set_dirty_bits(*node_, child_bit);
+
+                    if((node_->_mask & child_bit) == 0)
+                    {
+                        node_format new_node_{};
+                        new_node_._depth = depth_+1;
+                        new_node_._mask  = 0;
+                        // deepest node level points to voxel blocks
+                        new_node_._block_index = depth_+1 < MAX_DEPTH-1 ? 
+                            node_pool_.alloc() : 
+                            voxel_pool_.alloc();
+
+                        node_pool_._blocks[node_->_block_index][index] = new_node_;
+                        node_->_mask |= child_bit;
+                    }
+
+                    path_[depth_+1] = &node_pool_._blocks[node_->_block_index][index];
+                }
+
+                ////////////////////////
+                //     ALLOC VOXEL    //
+                ////////////////////////
+                node_format* node_ = path_[MAX_DEPTH-1];
+                const uint32_t index = static_cast<uint32_t>(morton_) & 7u;
+
+                node_->_mask |= static_cast<uint8_t>(1u << index);
+                set_dirty_bits(*node_, static_cast<uint8_t>(1u << index));
+                voxel_pool_._blocks[node_->_block_index][index] = voxels[sorted_[i]._index]._data;
+            }
+        }
+
+        void alloc_impl(morton_type voxel_morton, voxel_format& voxel)
+        { 
+            if constexpr (DETAILS._collapse_uniform) {
+                if(!expand_path(voxel_morton, &voxel)) {
+                    return; }
+            }
+
+            [[maybe_unused]] const auto lock_ = lock_octant(voxel_morton);
+            node_format* node_ = &_root_node;
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////            
+            // not tested with MSVC, with Clang on windows getting ~2x performance (my PC with 32^3 alloc benchmark, ~1.6m ns -> ~800k ns) 
+            // improvement from succesful unrolling for this specific traversing loop, this indicates signifigant overhead is caused by 
+            // branching and pipeline stalls
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-2; ++i)
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+                set_dirty_bits(*node_, child_bit);
+
+                // read before alloc, the node pool can relocate under node_
+                const uint32_t node_block_index = load_block_index(*node_);
+        
+                if(!exist)
+                {   
+                    if constexpr (!DETAILS._concurrent) {
+                        node_->_mask |= child_bit; }
+
+                    node_format new_node_{};
+                    new_node_._depth = i+1;
+                    new_node_._mask  = 0;
+                    new_node_._block_index = _node_pool.alloc();
+                    store_node(_node_pool._blocks[node_block_index][index], new_node_);
+
+                    // stable blocks, node_ survives the alloc and the child is published once written
+                    if constexpr (DETAILS._concurrent) {
+                        set_mask_bits(*node_, child_bit); }
+                } 
+
+                node_ = &_node_pool._blocks[node_block_index][index]; 
+            }
+
+            ////////////////////////
+            //    VOXEL OCTANT    //
+            ////////////////////////
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-2);
+                set_dirty_bits(*node_, child_bit);
+
+                auto& node_block_ = _node_pool._blocks[load_block_index(*node_)];
+
+                if(!exist)
+                {
+                    node_format new_node_{};
+                    new_node_._depth = MAX_DEPTH-1;
+                    new_node_._mask  = 0;
+                    // this time acquire voxel block index from voxel_pool
+                    new_node_._block_index = _voxel_pool.alloc();
+                    store_node(node_block_[index], new_node_);
+                    set_mask_bits(*node_, child_bit);
+                } 
+
+                node_ = &node_block_[index];
+            }
+
+            ////////////////////////
+            //     ALLOC VOXEL    //
+            ////////////////////////
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+                _voxel_pool._blocks[load_block_index(*node_)][index] = voxel;
+                set_mask_bits(*node_, child_bit);
+                set_dirty_bits(*node_, child_bit);
+            }
+
+            if constexpr (DETAILS._aggregate) {
+                update_aggregates(voxel_morton); }
+        }
+
+        voxel_format* get_impl(morton_type voxel_morton)
+        {
+            node_format* node_ = &_root_node;
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-1; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return nullptr;
+                }
+
+                node_ = &_node_pool._blocks[load_block_index(*node_)][index]; 
+
+                // the value shared by the whole subtree
+                if constexpr (DETAILS._collapse_uniform) {
+                    if(node_->_uniform) {
+                        return &_voxel_pool._blocks[node_->_block_index][0]; }
+                }
+            }
+            
+            ////////////////////////
+            //        VOXEL       //
+            ////////////////////////
+            SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+            if(!exist)
+            {
+                return nullptr;
+            }
+
+            return &_voxel_pool._blocks[load_block_index(*node_)][index];  
+        }
+
+        ////////////////////////
+        // deepest level nodes are 2 cells wide, so per axis the 3 cells of the block around a 
+        // voxel fall into 2 of them and the whole block into a 2x2x2 group, every cell is then 
+        // a slot in that group plus a child index, cells outside the bounds are flagged invalid
+        ////////////////////////
+        struct neighborhood_axis
+        {
+            // lowest deepest level node coordinate the block touches
+            uint32_t 
+            _first_leaf{};
+
+            bool 
+            _two_leaves{};
+
+            std::array<uint8_t, 3> 
+            _slot_bit{};
+
+            std::array<uint8_t, 3> 
+            _index_bit{};
+
+            std::array<bool, 3> 
+            _valid{};
+        };
+
+        static neighborhood_axis neighborhood_axis_of(uint32_t centre_, uint32_t axis_)
+        {
+            neighborhood_axis res_{};
+            const uint32_t lo_ = centre_ > 0 ? centre_ - 1 : centre_;
+            const uint32_t hi_ = centre_ + 1 < BOUNDS[axis_] ? centre_ + 1 : centre_;
+            res_._first_leaf = lo_ >> 1;
+            res_._two_leaves = (hi_ >> 1) != (lo_ >> 1);
+
+            for(uint32_t i = 0; i < 3; ++i) 
+            {
+                const uint32_t cell_ = centre_ + i - 1;
+                res_._valid[i] = (i != 0 || centre_ > 0) && (i != 2 || centre_ + 1 < BOUNDS[axis_]);
+                res_._slot_bit[i]  = res_._valid[i] ? static_cast<uint8_t>(((cell_ >> 1) - res_._first_leaf) << axis_) : 0;
+                res_._index_bit[i] = res_._valid[i] ? static_cast<uint8_t>((cell_ & 1u) << axis_) : 0;
+            }
+            return res_;
+        }
+
+        void get_neighborhood_impl(const vector_type& voxel_position, voxel_format** out)
+        {
+            static_assert(!DETAILS._collapse_uniform, "get_neighborhood() does not descend into collapsed subtrees");
+            const std::array<neighborhood_axis, 3> axes_{
+                neighborhood_axis_of(voxel_position[0], 0),
+                neighborhood_axis_of(voxel_position[1], 1),
+                neighborhood_axis_of(voxel_position[2], 2)};
+
+            ////////////////////////
+            //    LEAF  GROUP     //
+            ////////////////////////
+            // independent fixed length walks overlap far better than a shared but branchy descent
+            std::array<const node_format*, 8> group_{};
+            LOOP_UNROLL
+            for(uint32_t slot_ = 0; slot_ < 8; ++slot_)
+            {
+                bool used_ = true;
+                std::array<component_type, 3> cell_{};
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    const uint32_t upper_ = (slot_ >> axis_) & 1u;
+                    used_ &= !upper_ || axes_[axis_]._two_leaves;
+                    cell_[axis_] = static_cast<component_type>((axes_[axis_]._first_leaf + upper_) << 1);
+                }
+
+                morton_type leaf_morton_{};
+                morton_util<BIT_WIDTH>::pos_to_morton(leaf_morton_, &cell_[0]);
+                group_[slot_] = used_ ? leaf_node(leaf_morton_) : &EMPTY_NODE;
+            }
+
+            ////////////////////////
+            //       VOXELS       //
+            ////////////////////////
+            for(uint32_t z = 0; z < 3; ++z) {
+                for(uint32_t y = 0; y < 3; ++y) {
+                    LOOP_UNROLL
+                    for(uint32_t x = 0; x < 3; ++x) 
+                    {
+                        const node_format* node_ = group_[axes_[0]._slot_bit[x] | axes_[1]._slot_bit[y] | axes_[2]._slot_bit[z]];
+                        const uint32_t index = axes_[0]._index_bit[x] | axes_[1]._index_bit[y] | axes_[2]._index_bit[z];
+                        const bool exist = axes_[0]._valid[x] & axes_[1]._valid[y] & axes_[2]._valid[z] & ((load_mask(*node_) >> index) & 1u);
+                        // masked address instead of a select, the compiler turns the select into a branch
+                        const auto address_ = _voxel_pool.block_address(load_block_index(*node_)) + index * sizeof(voxel_format);
+                        out[x + 3 * y + 9 * z] = reinterpret_cast<voxel_format*>(address_ & (uintptr_t{0} - exist));
+                    }
+                }
+            }
+        }
+
+        // deepest level node holding voxel_morton, EMPTY_NODE when missing, fixed trip count without early out
+        const node_format* leaf_node(morton_type voxel_morton)
+        {
+            const node_format* node_ = &_root_node;
+            LOOP_UNROLL
+            for(uint32_t depth_ = 0; depth_ < MAX_DEPTH-1; ++depth_)
+            {
+                const uint32_t index = static_cast<uint32_t>(voxel_morton >> (3 * (MAX_DEPTH - 1 - depth_))) & 7u;
+                node_ = (load_mask(*node_) >> index) & 1u ? &_node_pool._blocks[load_block_index(*node_)][index] : &EMPTY_NODE;
+            }
+            return node_;
+        }
+
+        voxel_format* leaf_voxel(const node_format* leaf_, morton_type voxel_morton)
+        {
+            const uint32_t index = static_cast<uint32_t>(voxel_morton) & 7u;
+            return (load_mask(*leaf_) >> index) & 1u ? 
+                &_voxel_pool._blocks[load_block_index(*leaf_)][index] : 
+                nullptr;
+        }
+
+        ////////////////////////
+        // deepest level nodes are 2 cells wide, so per axis one face neighbour always shares the 
+        // centre's node and only the other one needs a walk of its own, the -1 / +1 neighbours are 
+        // stepped in dilated morton space
+        ////////////////////////
+        void get_face_neighborhood_impl(morton_type voxel_morton, voxel_format** out)
+        {
+            static_assert(!DETAILS._collapse_uniform, "get_face_neighborhood() does not descend into collapsed subtrees");
+            const node_format* leaf_ = leaf_node(voxel_morton);
+
+            LOOP_UNROLL
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                const auto axis_mask_ = static_cast<morton_type>(morton_util<BIT_WIDTH>::AXIS_MASK << axis_);
+                const auto axis_one_  = static_cast<morton_type>(1u << axis_);
+                const auto centre_    = static_cast<morton_type>(voxel_morton & axis_mask_);
+                const auto others_    = static_cast<morton_type>(voxel_morton & ~axis_mask_);
+                // filling the other axes' bits with ones carries the increment straight through them
+                const auto lower_ = static_cast<morton_type>(others_ | ((centre_ - axis_one_) & axis_mask_));
+                const auto upper_ = static_cast<morton_type>(others_ | (((centre_ | static_cast<morton_type>(~axis_mask_)) + axis_one_) & axis_mask_));
+                const bool has_lower_ = centre_ != 0;
+                const bool has_upper_ = (upper_ & axis_mask_) > centre_ && !is_overflow(upper_);
+
+                if((centre_ & axis_one_) == 0) {
+                    out[axis_ * 2]     = has_lower_ ? leaf_voxel(leaf_node(lower_), lower_) : nullptr;
+                    out[axis_ * 2 + 1] = has_upper_ ? leaf_voxel(leaf_, upper_) : nullptr;
+                } else {
+                    out[axis_ * 2]     = leaf_voxel(leaf_, lower_);
+                    out[axis_ * 2 + 1] = has_upper_ ? leaf_voxel(leaf_node(upper_), upper_) : nullptr;
+                }
+            }
+        }
+
+        const aggregate_type* get_lod_impl(morton_type voxel_morton, uint32_t level)
+        {
+            static_assert(DETAILS._aggregate, "get_lod() needs details_info::_aggregate");
+            assert(level < MAX_DEPTH);
+
+            if(_root_node._mask == 0) {
+                return nullptr; }
+            if(level == 0) {
+                return &_aggregates._root; }
+
+            const node_format* node_ = &_root_node;
+            for(uint32_t i = 0; i < level-1; ++i)
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist) {
+                    return nullptr; }
+
+                node_ = &_node_pool._blocks[node_->_block_index][index];
+            }
+
+            SVO_NODE_MORTON_CHILD_IMPL(level-1);
+            return exist ? &child_aggregates(*node_)[index] : nullptr;
+        }
+
+        std::array<aggregate_type, 8>& child_aggregates(const node_format& node_)
+        {
+            // the table follows the node pool lazily
+            if(node_._block_index >= _aggregates._blocks.size()) {
+                _aggregates._blocks.resize(_node_pool._blocks.size()); }
+            return _aggregates._blocks[node_._block_index];
+        }
+
+        // from the voxels at the deepest level, from the children's aggregates above
+        aggregate_type reduce_aggregate(const node_format& node_, uint32_t depth_)
+        {
+            if(depth_ == MAX_DEPTH-1) {
+                return aggregate_type::of(_voxel_pool._blocks[node_._block_index].data(), node_._mask); }
+            return aggregate_type::of(child_aggregates(node_).data(), node_._mask);
+        }
+
+        // reduces the nodes on the path to voxel_morton bottom-up, the path ends where a dealloc pruned it
+        void update_aggregates(morton_type voxel_morton)
+        {
+            std::array<const node_format*, MAX_DEPTH> path_{ &_root_node };
+            std::array<uint32_t, MAX_DEPTH> indices_{};
+            const node_format* node_ = &_root_node;
+
+            uint32_t depth_ = 0;
+            for(; depth_ < MAX_DEPTH-1; ++depth_)
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(depth_);
+
+                if(!exist) {
+                    break; }
+
+                node_ = &_node_pool._blocks[node_->_block_index][index];
+                path_[depth_+1] = node_;
+                indices_[depth_+1] = index;
+            }
+
+            for(; depth_ >= 1; --depth_) {
+                const aggregate_type aggregate_ = reduce_aggregate(*path_[depth_], depth_);
+                child_aggregates(*path_[depth_-1])[indices_[depth_]] = aggregate_; }
+            _aggregates._root = reduce_aggregate(_root_node, 0);
+        }
+
+        aggregate_type refresh_aggregates_impl(const node_format& node_, uint32_t depth_)
+        {
+            if(depth_ < MAX_DEPTH-1) 
+            {
+                for(uint8_t mask_ = node_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                    const auto index_ = std::countr_zero(mask_);
+                    const aggregate_type aggregate_ = refresh_aggregates_impl(_node_pool._blocks[node_._block_index][index_], depth_+1);
+                    child_aggregates(node_)[index_] = aggregate_; }
+            }
+            return reduce_aggregate(node_, depth_);
+        }
+
+        // bottom-up, a node's children are interned first so equal subtrees end up as equal records
+        frozen_node_format dag_record(const node_format& node_, uint32_t depth_, dag_tree<tree>& dag_) const
+        {
+            uint32_t count_ = 0;
+            if(depth_ == MAX_DEPTH-1)
+            {
+                std::array<voxel_format, 8> run_{};
+                const auto& voxel_block_ = _voxel_pool._blocks[node_._block_index];
+                for(uint8_t mask_ = node_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                    run_[count_++] = voxel_block_[std::countr_zero(mask_)]; }
+                return {dag_.intern_voxels(run_.data(), count_), node_._mask};
+            }
+
+            std::array<frozen_node_format, 8> run_{};
+            for(uint8_t mask_ = node_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                run_[count_++] = dag_record(_node_pool._blocks[node_._block_index][std::countr_zero(mask_)], depth_+1, dag_); }
+            return {dag_.intern_nodes(run_.data(), count_), node_._mask};
+        }
+
+        // the value if the subtree of node_ is full and holds a single value, nullptr otherwise, 
+        // subtrees below are collapsed on the way up
+        const voxel_format* collapse_impl(node_format& node_, uint32_t depth_)
+        {
+            if(node_._uniform) {
+                return &_voxel_pool._blocks[node_._block_index][0]; }
+
+            if(depth_ == MAX_DEPTH-1) 
+            {
+                const auto& voxel_block_ = _voxel_pool._blocks[node_._block_index];
+                if(node_._mask != 0xFF) {
+                    return nullptr; }
+                for(uint32_t i = 1; i < 8; ++i) {
+                    if(!(voxel_block_[i] == voxel_block_[0])) {
+                        return nullptr; }
+                }
+                return &voxel_block_[0];
+            }
+
+            // only deallocs below, the pools do not relocate
+            auto& children_ = _node_pool._blocks[node_._block_index];
+            const voxel_format* first_ = nullptr;
+            bool uniform_ = node_._mask == 0xFF;
+            for(uint8_t mask_ = node_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1))
+            {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(mask_));
+                const voxel_format* value_ = collapse_impl(children_[index_], depth_+1);
+                first_ = index_ == 0 ? value_ : first_;
+                uniform_ = uniform_ && value_ != nullptr && first_ != nullptr && *value_ == *first_;
+            }
+
+            if(!uniform_ || depth_ == 0) {
+                return nullptr; }
+
+            // every child refers to a voxel block holding the value at slot 0, the first child's 
+            // block keeps it, the free list overwrites the released blocks
+            const uint32_t value_block_ = children_[0]._block_index;
+            for(uint32_t i = 1; i < 8; ++i) {
+                _voxel_pool.dealloc(children_[i]._block_index); }
+            _node_pool.dealloc(node_._block_index);
+
+            node_._block_index = value_block_;
+            node_._uniform = 1;
+            // changes below stay visible through the parent's bit, see consume_dirty()
+            node_._dirty = 0;
+            return &_voxel_pool._blocks[value_block_][0];
+        }
+
+        // replaces the collapsed node at slot index_ of node block parent_block_ by 8 children holding its value
+        void expand_uniform(uint32_t parent_block_, uint32_t index_, uint32_t depth_)
+        {
+            const uint32_t value_block_ = _node_pool._blocks[parent_block_][index_]._block_index;
+            const voxel_format value_ = _voxel_pool._blocks[value_block_][0];
+            const uint32_t children_block_ = _node_pool.alloc();
+
+            for(uint32_t i = 0; i < 8; ++i)
+            {
+                node_format child_{};
+                child_._depth = static_cast<uint8_t>(depth_+1);
+                child_._mask  = 0xFF;
+                child_._block_index = i == 0 ? value_block_ : _voxel_pool.alloc();
+
+                // deepest level nodes own full voxel blocks, collapsed nodes only the value
+                if(depth_+1 == MAX_DEPTH-1) {
+                    _voxel_pool._blocks[child_._block_index].fill(value_);
+                } else {
+                    _voxel_pool._blocks[child_._block_index][0] = value_;
+                    child_._uniform = 1;
+                }
+                _node_pool._blocks[children_block_][i] = child_;
+            }
+
+            node_format& node_ = _node_pool._blocks[parent_block_][index_];
+            node_._block_index = children_block_;
+            node_._uniform = 0;
+        }
+
+        ////////////////////////
+        // expands the collapsed nodes on the path to voxel_morton so the plain write paths apply, 
+        // false if a collapsed node on the way already holds *value and the write changes nothing
+        ////////////////////////
+        bool expand_path(morton_type voxel_morton, const voxel_format* value)
+        {
+            const node_format* node_ = &_root_node;
+
+            // collapsed nodes live at depths 1 to MAX_DEPTH-2
+            for(uint32_t i = 0; i < MAX_DEPTH-2; ++i)
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist) {
+                    return true; }
+
+                const uint32_t node_block_index = node_->_block_index;
+                const node_format& child_ = _node_pool._blocks[node_block_index][index];
+                if(child_._uniform)
+                {
+                    if(value != nullptr && _voxel_pool._blocks[child_._block_index][0] == *value) {
+                        return false; }
+                    expand_uniform(node_block_index, index, i+1);
+                }
+
+                node_ = &_node_pool._blocks[node_block_index][index];
+            }
+            return true;
+        }
+
+        bool dealloc_impl(morton_type voxel_morton)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                expand_path(voxel_morton, nullptr); }
+
+            [[maybe_unused]] const auto lock_ = lock_octant(voxel_morton);
+            uint8_t depth_ = 0;
+            std::array<node_format*, MAX_DEPTH> path_{};
+            std::array<uint8_t, MAX_DEPTH> child_bits{};
+            auto voxel = 
+                get_traced_impl(
+                    voxel_morton, 
+                    &path_[0], 
+                    &child_bits[0], 
+                    &depth_);
+            
+            if(!voxel) {
+                return false;
+            }
+
+            if constexpr (DETAILS._track_dirty) {
+                for(uint32_t i = 0; i <= depth_; ++i) {
+                    set_dirty_bits(*path_[i], child_bits[i]); }
+            }
+            
+            if(clear_mask_bits(*path_[depth_], child_bits[depth_]) != 0){
+                if constexpr (DETAILS._aggregate) {
+                    update_aggregates(voxel_morton); }
+                return true;
+            }
+
+            // # if we got here, we can dealloc the whole voxel block
+
+            ///////////////////////////
+            //  DEALLOC VOXEL BLOCK  //
+            ///////////////////////////
+            
+            // unlinked before the block is released, readers never reach a released block afresh
+            clear_mask_bits(*path_[depth_-1], child_bits[depth_-1]);
+            _voxel_pool.dealloc(path_[depth_]->_block_index);
+            --depth_;
+            
+            ///////////////////////////
+            //  DEALLOC NODE BLOCKS  //
+            ///////////////////////////
+            
+            // traverse up, root node excluded
+            for(; depth_ >= 1; --depth_){
+                if(load_mask(*path_[depth_]) != 0) { 
+                    break; }
+                clear_mask_bits(*path_[depth_-1], child_bits[depth_-1]);
+                _node_pool.dealloc(path_[depth_]->_block_index);
+            }
+
+            if constexpr (DETAILS._aggregate) {
+                update_aggregates(voxel_morton); }
+            return true;
+        }
+
+        template<typename SHAPE_T>
+        uint64_t carve(const SHAPE_T& shape_)
+        {
+            constexpr std::array<uint32_t, 3> origin_{};
+            [[maybe_unused]] const auto locks_ = lock_octants(shape_children(0xFF, origin_, AXIS_WIDTH / 2, shape_));
+            const uint64_t removed_ = carve_impl(ROOT_BLOCK, 0, 0, origin_, shape_);
+
+            if constexpr (DETAILS._aggregate) {
+                _aggregates._root = reduce_aggregate(_root_node, 0); }
+            return removed_;
+        }
+
+        template<typename SHAPE_T, typename GENERATOR_T>
+        uint64_t fill(const SHAPE_T& shape_, GENERATOR_T& generator_)
+        {
+            constexpr std::array<uint32_t, 3> origin_{};
+            [[maybe_unused]] const auto locks_ = lock_octants(shape_children(0xFF, origin_, AXIS_WIDTH / 2, shape_));
+            const uint64_t written_ = fill_impl(ROOT_BLOCK, 0, 0, origin_, shape_, generator_);
+
+            if constexpr (DETAILS._aggregate) {
+                _aggregates._root = reduce_aggregate(_root_node, 0); }
+            return written_;
+        }
+
+        ////////////////////////
+        // removes the voxels of the shape below the node at slot index_ of node block block_ 
+        // (ROOT_BLOCK for the root) whose extent starts at origin_, children fully inside go whole, 
+        // children on the surface are descended, both are unlinked before their blocks are released
+        ////////////////////////
+        template<typename SHAPE_T>
+        uint64_t carve_impl(uint32_t block_, uint32_t index_, uint32_t depth_, const std::array<uint32_t, 3>& origin_, const SHAPE_T& shape_)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                if(block_ != ROOT_BLOCK && _node_pool._blocks[block_][index_]._uniform) {
+                    expand_uniform(block_, index_, depth_); }
+            }
+
+            // expanding below allocates, the node pool can relocate under a held reference
+            auto node_of_ = [&]() -> node_format& {
+                return block_ == ROOT_BLOCK ? _root_node : _node_pool._blocks[block_][index_]; };
+
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_ + 1);
+            const uint8_t hit_ = shape_children(load_mask(node_of_()), origin_, child_size_, shape_);
+
+            ////////////////////////
+            //       VOXELS       //
+            ////////////////////////
+            if(depth_ == MAX_DEPTH-1) 
+            {
+                clear_mask_bits(node_of_(), hit_);
+                set_dirty_bits(node_of_(), hit_);
+                return static_cast<uint64_t>(std::popcount(hit_));
+            }
+
+            const uint32_t children_block_ = load_block_index(node_of_());
+            uint64_t removed_ = 0;
+            uint8_t whole_ = 0;
+            uint8_t touched_ = 0;
+            uint8_t emptied_ = 0;
+            for(uint8_t pending_ = hit_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index = static_cast<uint32_t>(std::countr_zero(pending_));
+                const auto child_bit_ = static_cast<uint8_t>(1u << index);
+                const std::array<uint32_t, 3> child_origin_ = child_origin(origin_, child_size_, index);
+
+                if(shape_.contains(child_origin_, child_size_)) {
+                    whole_ |= child_bit_;
+                    continue; }
+
+                const uint64_t child_removed_ = carve_impl(children_block_, index, depth_+1, child_origin_, shape_);
+                if(child_removed_ == 0) {
+                    continue; }
+
+                removed_ += child_removed_;
+                touched_ |= child_bit_;
+
+                const node_format& child_ = _node_pool._blocks[children_block_][index];
+                if(load_mask(child_) == 0) {
+                    emptied_ |= child_bit_; 
+                } else {
+                    if constexpr (DETAILS._aggregate) {
+                        const aggregate_type aggregate_ = reduce_aggregate(child_, depth_+1);
+                        child_aggregates(node_of_())[index] = aggregate_; }
+                }
+            }
+
+            const auto released_ = static_cast<uint8_t>(whole_ | emptied_);
+            clear_mask_bits(node_of_(), released_);
+            set_dirty_bits(node_of_(), static_cast<uint8_t>(whole_ | touched_));
+
+            for(uint8_t pending_ = released_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) {
+                removed_ += dealloc_subtree(_node_pool._blocks[children_block_][std::countr_zero(pending_)], depth_+1); }
+            return removed_;
+        }
+
+        ////////////////////////
+        // writes the voxels of the shape below the node at slot index_ of node block block_, children 
+        // fully inside are built whole and replace what was there, children on the surface are created 
+        // when missing and descended, a child is linked only once everything below it is written
+        ////////////////////////
+        template<typename SHAPE_T, typename GENERATOR_T>
+        uint64_t fill_impl(uint32_t block_, uint32_t index_, uint32_t depth_, const std::array<uint32_t, 3>& origin_, 
+            const SHAPE_T& shape_, GENERATOR_T& generator_)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                if(block_ != ROOT_BLOCK && _node_pool._blocks[block_][index_]._uniform) {
+                    expand_uniform(block_, index_, depth_); }
+            }
+
+            // building below allocates, the node pool can relocate under a held reference
+            auto node_of_ = [&]() -> node_format& {
+                return block_ == ROOT_BLOCK ? _root_node : _node_pool._blocks[block_][index_]; };
+
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_ + 1);
+
+            ////////////////////////
+            //       VOXELS       //
+            ////////////////////////
+            if(depth_ == MAX_DEPTH-1) 
+            {
+                auto& voxel_block_ = _voxel_pool._blocks[load_block_index(node_of_())];
+                uint8_t written_ = 0;
+                for(uint32_t index = 0; index < 8; ++index)
+                {
+                    const std::array<uint32_t, 3> position_ = child_origin(origin_, 1, index);
+                    if(!reaches_bounds(position_) || !shape_.contains(position_, 1)) {
+                        continue; }
+                    const vector_type voxel_position_(position_[0], position_[1], position_[2]);
+                    voxel_block_[index] = generator_(voxel_position_);
+                    written_ |= static_cast<uint8_t>(1u << index);
+                }
+                set_mask_bits(node_of_(), written_);
+                set_dirty_bits(node_of_(), written_);
+                return static_cast<uint64_t>(std::popcount(written_));
+            }
+
+            const uint32_t children_block_ = load_block_index(node_of_());
+            uint64_t written_ = 0;
+            uint8_t touched_ = 0;
+            for(uint8_t pending_ = shape_children(0xFF, origin_, child_size_, shape_); pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index = static_cast<uint32_t>(std::countr_zero(pending_));
+                const auto child_bit_ = static_cast<uint8_t>(1u << index);
+                const std::array<uint32_t, 3> child_origin_ = child_origin(origin_, child_size_, index);
+                if(!reaches_bounds(child_origin_)) {
+                    continue; }
+
+                const bool exist_ = (load_mask(node_of_()) & child_bit_) != 0;
+
+                ////////////////////////
+                //    WHOLE SUBTREE   //
+                ////////////////////////
+                if(within_bounds(child_origin_, child_size_) && shape_.contains(child_origin_, child_size_))
+                {
+                    const node_format built_ = build_subtree(child_origin_, depth_+1, generator_);
+                    const node_format replaced_ = _node_pool._blocks[children_block_][index];
+
+                    // unlinked while the slot changes, readers see the child missing or complete
+                    clear_mask_bits(node_of_(), child_bit_);
+                    store_node(_node_pool._blocks[children_block_][index], built_);
+                    set_mask_bits(node_of_(), child_bit_);
+                    if(exist_) {
+                        dealloc_subtree(replaced_, depth_+1); }
+
+                    written_ += uint64_t{1} << (3 * (MAX_DEPTH - (depth_+1)));
+                    touched_ |= child_bit_;
+                    if constexpr (DETAILS._aggregate) {
+                        const aggregate_type aggregate_ = reduce_aggregate(built_, depth_+1);
+                        child_aggregates(node_of_())[index] = aggregate_; }
+                    continue;
+                }
+
+                ////////////////////////
+                //       SURFACE      //
+                ////////////////////////
+                if(!exist_)
+                {
+                    node_format new_node_{};
+                    new_node_._depth = static_cast<uint8_t>(depth_+1);
+                    new_node_._mask  = 0;
+                    new_node_._block_index = depth_+1 == MAX_DEPTH-1 ? _voxel_pool.alloc() : _node_pool.alloc();
+                    store_node(_node_pool._blocks[children_block_][index], new_node_);
+                }
+
+                const uint64_t child_written_ = fill_impl(children_block_, index, depth_+1, child_origin_, shape_, generator_);
+                if(child_written_ == 0) 
+                {
+                    // the shape only grazed the cube, a child created for it goes again
+                    if(!exist_) {
+                        dealloc_subtree(_node_pool._blocks[children_block_][index], depth_+1); }
+                    continue;
+                }
+
+                written_ += child_written_;
+                touched_ |= child_bit_;
+                set_mask_bits(node_of_(), child_bit_);
+                if constexpr (DETAILS._aggregate) {
+                    const aggregate_type aggregate_ = reduce_aggregate(_node_pool._blocks[children_block_][index], depth_+1);
+                    child_aggregates(node_of_())[index] = aggregate_; }
+            }
+
+            set_dirty_bits(node_of_(), touched_);
+            return written_;
+        }
+
+        // a fully occupied subtree holding generator_ for every voxel, not linked yet
+        template<typename GENERATOR_T>
+        node_format build_subtree(const std::array<uint32_t, 3>& origin_, uint32_t depth_, GENERATOR_T& generator_)
+        {
+            node_format node_{};
+            node_._depth = static_cast<uint8_t>(depth_);
+            node_._mask  = 0xFF;
+            // consume_dirty() finds changed regions by descending dirty bits
+            if constexpr (DETAILS._track_dirty) {
+                node_._dirty = 0xFF; }
+
+            if(depth_ == MAX_DEPTH-1)
+            {
+                node_._block_index = _voxel_pool.alloc();
+                auto& voxel_block_ = _voxel_pool._blocks[node_._block_index];
+                for(uint32_t index = 0; index < 8; ++index) {
+                    const std::array<uint32_t, 3> position_ = child_origin(origin_, 1, index);
+                    const vector_type voxel_position_(position_[0], position_[1], position_[2]);
+                    voxel_block_[index] = generator_(voxel_position_); }
+                return node_;
+            }
+
+            node_._block_index = _node_pool.alloc();
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_ + 1);
+            for(uint32_t index = 0; index < 8; ++index)
+            {
+                const node_format child_ = build_subtree(child_origin(origin_, child_size_, index), depth_+1, generator_);
+                _node_pool._blocks[node_._block_index][index] = child_;
+                if constexpr (DETAILS._aggregate) {
+                    const aggregate_type aggregate_ = reduce_aggregate(child_, depth_+1);
+                    child_aggregates(node_)[index] = aggregate_; }
+            }
+            return node_;
+        }
+
+        template<csg_op OP, typename MERGE_T>
+        void csg(const tree& b, const glm::ivec3& offset, MERGE_T& merge_)
+        {
+            static_assert(!DETAILS._concurrent && !DETAILS._collapse_uniform, "tree CSG needs no concurrent mode and no collapsing");
+            assert(&b != this);
+
+            const std::array<int32_t, 3> offset_{offset[0], offset[1], offset[2]};
+            constexpr auto WIDTH = static_cast<int32_t>(AXIS_WIDTH);
+
+            // the root of b is the one cell of the block around the root extent sitting at the origin of b
+            csg_cells cells_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                cells_._origin[axis_] = util::floor_div(-offset_[axis_], WIDTH) * WIDTH; }
+            for(uint32_t cell_ = 0; cell_ < 8; ++cell_) {
+                const std::array<uint32_t, 3> grid_{cell_ & 1u, (cell_ >> 1) & 1u, cell_ >> 2};
+                const bool origin_ = 
+                    cells_._origin[0] + static_cast<int32_t>(grid_[0]) * WIDTH == 0 && 
+                    cells_._origin[1] + static_cast<int32_t>(grid_[1]) * WIDTH == 0 && 
+                    cells_._origin[2] + static_cast<int32_t>(grid_[2]) * WIDTH == 0;
+                cells_._nodes[cell_] = origin_ && b._root_node._mask != 0 ? &b._root_node : nullptr;
+            }
+
+            csg_impl<OP>(b, ROOT_BLOCK, 0, 0, {0, 0, 0}, cells_, offset_, merge_);
+
+            if constexpr (DETAILS._aggregate) {
+                _aggregates._root = reduce_aggregate(_root_node, 0); }
+        }
+
+        // the nodes of b one depth below cells_ around the children of edge size_ of the extent with 
+        // lower corner corner_ (in the space of b)
+        static csg_grid csg_child_grid(const tree& b, const csg_cells& cells_, const std::array<int32_t, 3>& corner_, int32_t size_)
+        {
+            // sizes are powers of two, masking floors toward negative infinity
+            const auto shift_ = static_cast<uint32_t>(std::countr_zero(static_cast<uint32_t>(size_)));
+            constexpr std::array<uint8_t, 3> LOWER_HALF{0x55, 0x33, 0x0F};
+
+            csg_grid grid_{};
+            grid_._size = size_;
+            std::array<uint32_t, 3> first_{};
+            std::array<uint32_t, 3> count_{};
+            std::array<std::array<uint8_t, 2>, 3> halves_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) 
+            {
+                grid_._origin[axis_] = corner_[axis_] & -size_;
+                first_[axis_] = static_cast<uint32_t>(grid_._origin[axis_] - cells_._origin[axis_]) >> shift_;
+
+                // a child reaches the upper half of its lower cell, the lower half of its upper cell 
+                // and the upper cell at all only when it is not aligned to them
+                const int32_t shift_in_cell_ = corner_[axis_] - grid_._origin[axis_];
+                const auto lower_ = LOWER_HALF[axis_];
+                const auto upper_ = static_cast<uint8_t>(~LOWER_HALF[axis_]);
+                count_[axis_] = shift_in_cell_ == 0 ? 2 : 3;
+                halves_[axis_][0] = static_cast<uint8_t>(upper_ | (shift_in_cell_ < size_/2 ? lower_ : 0u));
+                halves_[axis_][1] = shift_in_cell_ == 0 ? 0 : static_cast<uint8_t>(lower_ | (shift_in_cell_ > size_/2 ? upper_ : 0u));
+            }
+            for(uint32_t cell_ = 0; cell_ < 8; ++cell_) {
+                grid_._covered[cell_] = halves_[0][cell_ & 1u] & halves_[1][(cell_ >> 1) & 1u] & halves_[2][cell_ >> 2]; }
+
+            for(uint32_t z = 0; z < count_[2]; ++z) {
+                for(uint32_t y = 0; y < count_[1]; ++y) {
+                    for(uint32_t x = 0; x < count_[0]; ++x) 
+                    {
+                        // position in the 4x4x4 block of children below cells_
+                        const std::array<uint32_t, 3> position_{first_[0] + x, first_[1] + y, first_[2] + z};
+                        const node_format* parent_ = cells_._nodes[(position_[0] >> 1) | ((position_[1] >> 1) << 1) | ((position_[2] >> 1) << 2)];
+                        const uint32_t index_ = (position_[0] & 1u) | ((position_[1] & 1u) << 1) | ((position_[2] & 1u) << 2);
+                        if(parent_ != nullptr && ((parent_->_mask >> index_) & 1u)) {
+                            grid_._nodes[x + 3*y + 9*z] = &b._node_pool._blocks[parent_->_block_index][index_]; 
+                            grid_._occupied |= 1u << (x + 3*y + 9*z); }
+                    }
+                }
+            }
+            return grid_;
+        }
+
+        // the cells of grid_ around child index_, leaving out cells whose children all lie outside of it
+        static csg_cells csg_child_cells(const csg_grid& grid_, uint32_t index_)
+        {
+            const std::array<uint32_t, 3> child_{index_ & 1u, (index_ >> 1) & 1u, index_ >> 2};
+            csg_cells cells_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                cells_._origin[axis_] = grid_._origin[axis_] + static_cast<int32_t>(child_[axis_]) * grid_._size; }
+
+            // the grid cells 0, 1, 3, 4, 9, 10, 12 and 13 around the first child
+            constexpr uint32_t FIRST_CHILD_CELLS = 0x361B;
+            if(((grid_._occupied >> (child_[0] + 3*child_[1] + 9*child_[2])) & FIRST_CHILD_CELLS) == 0) {
+                return cells_; }
+
+            for(uint32_t cell_ = 0; cell_ < 8; ++cell_) {
+                const node_format* node_ = grid_._nodes[
+                    (child_[0] + (cell_ & 1u)) + 3*(child_[1] + ((cell_ >> 1) & 1u)) + 9*(child_[2] + (cell_ >> 2))];
+                if(node_ != nullptr && (node_->_mask & grid_._covered[cell_]) != 0) {
+                    cells_._nodes[cell_] = node_; }
+            }
+            return cells_;
+        }
+
+        // the voxel of b at position_ (in the space of b) below cells_ at MAX_DEPTH-1, nullptr when there is none
+        static const voxel_format* csg_voxel(const tree& b, const csg_cells& cells_, const std::array<int32_t, 3>& position_)
+        {
+            std::array<uint32_t, 3> grid_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                grid_[axis_] = static_cast<uint32_t>(position_[axis_] - cells_._origin[axis_]); }
+
+            const node_format* parent_ = cells_._nodes[(grid_[0] >> 1) | ((grid_[1] >> 1) << 1) | ((grid_[2] >> 1) << 2)];
+            const uint32_t index_ = (grid_[0] & 1u) | ((grid_[1] & 1u) << 1) | ((grid_[2] & 1u) << 2);
+            return parent_ != nullptr && ((parent_->_mask >> index_) & 1u) ? &b._voxel_pool._blocks[parent_->_block_index][index_] : nullptr;
+        }
+
+        ////////////////////////
+        // combines the nodes of b in cells_ into the node at slot index_ of node block block_ 
+        // (ROOT_BLOCK for the root) whose extent starts at origin_, true if anything below changed, 
+        // children left empty are unlinked before their blocks are released
+        ////////////////////////
+        template<csg_op OP, typename MERGE_T>
+        bool csg_impl(const tree& b, uint32_t block_, uint32_t index_, uint32_t depth_, const std::array<uint32_t, 3>& origin_, 
+            const csg_cells& cells_, const std::array<int32_t, 3>& offset_, MERGE_T& merge_)
+        {
+            // creating and copying children allocates, the node pool can relocate under a held reference
+            auto node_of_ = [&]() -> node_format& {
+                return block_ == ROOT_BLOCK ? _root_node : _node_pool._blocks[block_][index_]; };
+
+            ////////////////////////
+            //       VOXELS       //
+            ////////////////////////
+            if(depth_ == MAX_DEPTH-1) 
+            {
+                auto& voxel_block_ = _voxel_pool._blocks[node_of_()._block_index];
+                const uint8_t mask_ = node_of_()._mask;
+                uint8_t set_ = 0;
+                uint8_t cleared_ = 0;
+                for(uint32_t index = 0; index < 8; ++index)
+                {
+                    const std::array<uint32_t, 3> position_ = child_origin(origin_, 1, index);
+                    const voxel_format* source_ = csg_voxel(b, cells_, {
+                        static_cast<int32_t>(position_[0]) - offset_[0], 
+                        static_cast<int32_t>(position_[1]) - offset_[1], 
+                        static_cast<int32_t>(position_[2]) - offset_[2]});
+                    const auto bit_ = static_cast<uint8_t>(1u << index);
+                    const bool target_ = (mask_ & bit_) != 0;
+
+                    if constexpr (OP == csg_op::unite) {
+                        if(source_ == nullptr || !reaches_bounds(position_)) {
+                            continue; }
+                        voxel_block_[index] = target_ ? merge_(static_cast<const voxel_format&>(voxel_block_[index]), *source_) : *source_;
+                        set_ |= bit_;
+                    } else if constexpr (OP == csg_op::intersect) {
+                        if(!target_) {
+                            continue; }
+                        if(source_ == nullptr) {
+                            cleared_ |= bit_;
+                            continue; }
+                        voxel_block_[index] = merge_(static_cast<const voxel_format&>(voxel_block_[index]), *source_);
+                        set_ |= bit_;
+                    } else {
+                        if(target_ && source_ != nullptr) {
+                            cleared_ |= bit_; }
+                    }
+                }
+
+                node_format& node_ = node_of_();
+                node_._mask = static_cast<uint8_t>((mask_ | set_) & ~cleared_);
+                set_dirty_bits(node_, static_cast<uint8_t>(set_ | cleared_));
+                return (set_ | cleared_) != 0;
+            }
+
+            const uint32_t children_block_ = node_of_()._block_index;
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_ + 1);
+            uint8_t changed_ = 0;
+            uint8_t released_ = 0;
+
+            const csg_grid grid_ = csg_child_grid(b, cells_, {
+                static_cast<int32_t>(origin_[0]) - offset_[0], 
+                static_cast<int32_t>(origin_[1]) - offset_[1], 
+                static_cast<int32_t>(origin_[2]) - offset_[2]}, static_cast<int32_t>(child_size_));
+
+            // only a union adds children
+            const uint8_t candidates_ = OP == csg_op::unite ? 0xFF : node_of_()._mask;
+            for(uint8_t pending_ = candidates_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index = static_cast<uint32_t>(std::countr_zero(pending_));
+                const auto child_bit_ = static_cast<uint8_t>(1u << index);
+                const std::array<uint32_t, 3> child_origin_ = child_origin(origin_, child_size_, index);
+                if(!reaches_bounds(child_origin_)) {
+                    continue; }
+
+                const std::array<int32_t, 3> corner_{
+                    static_cast<int32_t>(child_origin_[0]) - offset_[0], 
+                    static_cast<int32_t>(child_origin_[1]) - offset_[1], 
+                    static_cast<int32_t>(child_origin_[2]) - offset_[2]};
+                const csg_cells child_cells_ = csg_child_cells(grid_, index);
+                const bool source_ = std::any_of(child_cells_._nodes.begin(), child_cells_._nodes.end(), [](const node_format* node_) { return node_ != nullptr; });
+                const bool exist_ = (node_of_()._mask & child_bit_) != 0;
+
+                // b holds nothing here
+                if(!source_) 
+                {
+                    if constexpr (OP == csg_op::intersect) {
+                        released_ |= child_bit_;
+                        changed_ |= child_bit_; }
+                    continue;
+                }
+
+                if(!exist_)
+                {
+                    if constexpr (OP != csg_op::unite) {
+                        continue; }
+
+                    ////////////////////////
+                    //    COPY SUBTREE    //
+                    ////////////////////////
+                    if(corner_ == child_cells_._origin && within_bounds(child_origin_, child_size_))
+                    {
+                        const node_format copied_ = copy_subtree(b, *child_cells_._nodes[0], depth_+1);
+                        store_node(_node_pool._blocks[children_block_][index], copied_);
+                        set_mask_bits(node_of_(), child_bit_);
+                        changed_ |= child_bit_;
+                        if constexpr (DETAILS._aggregate) {
+                            const aggregate_type aggregate_ = reduce_aggregate(copied_, depth_+1);
+                            child_aggregates(node_of_())[index] = aggregate_; }
+                        continue;
+                    }
+
+                    node_format new_node_{};
+                    new_node_._depth = static_cast<uint8_t>(depth_+1);
+                    new_node_._mask  = 0;
+                    new_node_._block_index = depth_+1 == MAX_DEPTH-1 ? _voxel_pool.alloc() : _node_pool.alloc();
+                    store_node(_node_pool._blocks[children_block_][index], new_node_);
+                }
+
+                if(!csg_impl<OP>(b, children_block_, index, depth_+1, child_origin_, child_cells_, offset_, merge_)) 
+                {
+                    // b only grazed the extent, a child created for it goes again
+                    if(!exist_) {
+                        dealloc_subtree(_node_pool._blocks[children_block_][index], depth_+1); }
+                    continue;
+                }
+
+                changed_ |= child_bit_;
+                const node_format& child_ = _node_pool._blocks[children_block_][index];
+                if(child_._mask == 0) {
+                    released_ |= child_bit_;
+                    continue; }
+
+                set_mask_bits(node_of_(), child_bit_);
+                if constexpr (DETAILS._aggregate) {
+                    const aggregate_type aggregate_ = reduce_aggregate(child_, depth_+1);
+                    child_aggregates(node_of_())[index] = aggregate_; }
+            }
+
+            clear_mask_bits(node_of_(), released_);
+            set_dirty_bits(node_of_(), changed_);
+            for(uint8_t pending_ = released_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) {
+                dealloc_subtree(_node_pool._blocks[children_block_][std::countr_zero(pending_)], depth_+1); }
+            return changed_ != 0;
+        }
+
+        // a copy of the subtree of node source_ of b in the pools of this tree, not linked yet
+        node_format copy_subtree(const tree& b, const node_format& source_, uint32_t depth_)
+        {
+            node_format node_{};
+            node_._depth = static_cast<uint8_t>(depth_);
+            node_._mask  = source_._mask;
+            // consume_dirty() finds changed regions by descending dirty bits
+            if constexpr (DETAILS._track_dirty) {
+                node_._dirty = source_._mask; }
+
+            if(depth_ == MAX_DEPTH-1)
+            {
+                node_._block_index = _voxel_pool.alloc();
+                _voxel_pool._blocks[node_._block_index] = b._voxel_pool._blocks[source_._block_index];
+                return node_;
+            }
+
+            node_._block_index = _node_pool.alloc();
+            for(uint8_t mask_ = source_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1))
+            {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(mask_));
+                const node_format child_ = copy_subtree(b, b._node_pool._blocks[source_._block_index][index_], depth_+1);
+                _node_pool._blocks[node_._block_index][index_] = child_;
+                if constexpr (DETAILS._aggregate) {
+                    const aggregate_type aggregate_ = reduce_aggregate(child_, depth_+1);
+                    child_aggregates(node_)[index_] = aggregate_; }
+            }
+            return node_;
+        }
+
+        template<voxel_connectivity CONNECT, bool DETACHED, typename CALLBACK_T>
+        uint32_t components(const vector_type& box_min, const vector_type& box_max,
+            const vector_type* anchors_, size_t anchor_count_, CALLBACK_T& callback_)
+        {
+            component_search search_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                if(box_min[axis_] > box_max[axis_] || box_min[axis_] >= BOUNDS[axis_]) {
+                    return 0; }
+                search_._min[axis_] = box_min[axis_];
+                search_._max[axis_] = util::min<uint32_t>(box_max[axis_], BOUNDS[axis_] - 1);
+            }
+            if(_root_node._mask == 0) {
+                return 0; }
+
+            search_._node_pieces.assign(_node_pool._blocks.size(), NO_PIECE);
+            search_._voxel_pieces.assign(_voxel_pool._blocks.size(), NO_PIECE);
+            if constexpr (!DETAILS._aggregate) {
+                search_._full.assign(_node_pool._blocks.size(), 0);
+                mark_full_subtrees(_root_node, {0, 0, 0}, 0, search_); }
+
+            const component_cell root_{&_root_node, {0, 0, 0}, 0};
+            component_cell_proc<CONNECT>(root_, search_);
+
+            // anchors count for the whole component
+            auto& parents_ = search_._parents;
+            auto& anchored_ = search_._anchored;
+            for(uint32_t piece_ = 0; piece_ < parents_.size(); ++piece_) {
+                anchored_[find_piece(parents_, piece_)] |= anchored_[piece_]; }
+            for(size_t i = 0; i < anchor_count_; ++i)
+            {
+                const uint32_t piece_ = anchor_piece<CONNECT>(anchors_[i], search_);
+                if(piece_ != NO_PIECE) {
+                    anchored_[find_piece(parents_, piece_)] = 1; }
+            }
+
+            std::vector<uint32_t> labels_(parents_.size(), NO_PIECE);
+            uint32_t count_ = 0;
+            report_components<CONNECT, DETACHED>(root_, search_, labels_, count_, callback_);
+            return count_;
+        }
+
+        // records for the nodes in the box whether their subtree is fully occupied,
+        // nodes with children outside of the box are left as not
+        bool mark_full_subtrees(const node_format& node_, const std::array<uint32_t, 3>& origin_, uint32_t depth_, component_search& search_)
+        {
+            if(depth_ == MAX_DEPTH-1) {
+                return node_._mask == 0xFF; }
+            if constexpr (DETAILS._collapse_uniform) {
+                if(node_._uniform) {
+                    return true; } }
+
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_+1);
+            const uint8_t reached_ = box_children(node_._mask, origin_, child_size_, search_._min, search_._max);
+            bool full_ = reached_ == 0xFF;
+            for(uint8_t pending_ = reached_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(pending_));
+                full_ = mark_full_subtrees(_node_pool._blocks[node_._block_index][index_],
+                    child_origin(origin_, child_size_, index_), depth_+1, search_) && full_;
+            }
+            search_._full[node_._block_index] = full_;
+            return full_;
+        }
+
+        // whether the subtree of a node above the voxel blocks is fully occupied
+        bool subtree_full(const node_format& node_, uint32_t depth_, const component_search& search_)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                if(node_._uniform) {
+                    return true; } }
+
+            if constexpr (DETAILS._aggregate)
+            {
+                if(node_._mask != 0xFF) {
+                    return false; }
+                uint64_t count_ = 0;
+                for(const aggregate_type& aggregate_ : child_aggregates(node_)) {
+                    count_ += aggregate_._count; }
+                return count_ == uint64_t{1} << (3 * (MAX_DEPTH - depth_));
+            }
+            else {
+                return search_._full[node_._block_index] != 0; }
+        }
+
+        // the walk stops at empty cells, voxel blocks and fully occupied subtrees
+        bool component_leaf(const component_cell& cell_, const component_search& search_)
+        {
+            return cell_._node == nullptr || cell_._depth == MAX_DEPTH-1 || subtree_full(*cell_._node, cell_._depth, search_);
+        }
+
+        // child index_ of a cell with the box applied, leaves stand in for their own children
+        component_cell component_child(const component_cell& cell_, bool leaf_, uint32_t index_, const component_search& search_)
+        {
+            if(leaf_) {
+                return cell_; }
+
+            const uint32_t child_size_ = AXIS_WIDTH >> (cell_._depth+1);
+            const uint8_t reached_ = box_children(cell_._node->_mask, cell_._origin, child_size_, search_._min, search_._max);
+            if(((reached_ >> index_) & 1u) == 0) {
+                return {}; }
+            return {&_node_pool._blocks[cell_._node->_block_index][index_], child_origin(cell_._origin, child_size_, index_), cell_._depth+1};
+        }
+
+        // voxels of a voxel block inside the box
+        static uint8_t component_voxels(const component_cell& cell_, const component_search& search_)
+        {
+            return box_children(cell_._node->_mask, cell_._origin, 1, search_._min, search_._max);
+        }
+
+        // the first piece of a leaf
+        static uint32_t& leaf_piece(const node_format& node_, uint32_t depth_, component_search& search_)
+        {
+            bool voxels_ = depth_ == MAX_DEPTH-1;
+            if constexpr (DETAILS._collapse_uniform) {
+                voxels_ = voxels_ || node_._uniform; }
+            return voxels_ ? search_._voxel_pieces[node_._block_index] : search_._node_pieces[node_._block_index];
+        }
+
+        // a piece of leaf cell_ holding a voxel in octants_ of a voxel block, NO_PIECE when there is none,
+        // a fully occupied subtree is one piece everywhere
+        template<voxel_connectivity CONNECT>
+        static uint32_t leaf_piece_in(const component_cell& cell_, uint8_t octants_, component_search& search_)
+        {
+            if(cell_._node == nullptr) {
+                return NO_PIECE; }
+            const uint32_t first_ = leaf_piece(*cell_._node, cell_._depth, search_);
+            if(cell_._depth < MAX_DEPTH-1) {
+                return first_; }
+
+            const uint8_t voxels_ = component_voxels(cell_, search_);
+            const auto present_ = static_cast<uint8_t>(voxels_ & octants_);
+            if(present_ == 0) {
+                return NO_PIECE; }
+            if constexpr (CONNECT == connect_all) {
+                return first_; }
+            else {
+                return first_ + util::BLOCK_COMPONENTS._labels[voxels_][std::countr_zero(present_)]; }
+        }
+
+        // whether an extent reaches a face the box does not share with the tree
+        static bool reaches_box_seam(const std::array<uint32_t, 3>& origin_, uint32_t size_, const component_search& search_)
+        {
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                if((search_._min[axis_] > 0 && origin_[axis_] <= search_._min[axis_]) ||
+                   (search_._max[axis_] < BOUNDS[axis_] - 1 && origin_[axis_] + size_ - 1 >= search_._max[axis_])) {
+                    return true; } }
+            return false;
+        }
+
+        // numbers the pieces of a leaf, those reaching a seam of the box are anchored
+        template<voxel_connectivity CONNECT>
+        void add_leaf_pieces(const component_cell& cell_, component_search& search_)
+        {
+            const auto first_ = static_cast<uint32_t>(search_._parents.size());
+            leaf_piece(*cell_._node, cell_._depth, search_) = first_;
+
+            if(cell_._depth < MAX_DEPTH-1)
+            {
+                search_._parents.push_back(first_);
+                search_._anchored.push_back(reaches_box_seam(cell_._origin, AXIS_WIDTH >> cell_._depth, search_));
+                return;
+            }
+
+            const uint8_t voxels_ = component_voxels(cell_, search_);
+            const uint32_t count_ = CONNECT == connect_all ? (voxels_ != 0) : util::BLOCK_COMPONENTS._counts[voxels_];
+            for(uint32_t i = 0; i < count_; ++i) {
+                search_._parents.push_back(first_ + i);
+                search_._anchored.push_back(0); }
+
+            for(uint8_t pending_ = voxels_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(pending_));
+                if(reaches_box_seam(child_origin(cell_._origin, 1, index_), 1, search_)) {
+                    const uint32_t label_ = CONNECT == connect_all ? 0 : util::BLOCK_COMPONENTS._labels[voxels_][index_];
+                    search_._anchored[first_ + label_] = 1; }
+            }
+        }
+
+        static uint32_t find_piece(std::vector<uint32_t>& parents_, uint32_t piece_)
+        {
+            // path halving
+            while(parents_[piece_] != piece_) {
+                parents_[piece_] = parents_[parents_[piece_]];
+                piece_ = parents_[piece_]; }
+            return piece_;
+        }
+
+        static void join_pieces(std::vector<uint32_t>& parents_, uint32_t a_, uint32_t b_)
+        {
+            if(a_ == NO_PIECE || b_ == NO_PIECE) {
+                return; }
+            a_ = find_piece(parents_, a_);
+            b_ = find_piece(parents_, b_);
+            if(a_ < b_) {
+                parents_[b_] = a_; }
+            else {
+                parents_[a_] = b_; }
+        }
+
+        // the octants of a block on the upper or lower side of axis_
+        static uint8_t side_octants(uint32_t axis_, bool upper_)
+        {
+            constexpr std::array<uint8_t, 3> LOWER = {0x55, 0x33, 0x0F};
+            return upper_ ? static_cast<uint8_t>(~LOWER[axis_]) : LOWER[axis_];
+        }
+
+        ////////////////////////
+        // joins the pieces touching inside a cell, every cell is numbered before the faces, edges
+        // and corners between them are walked, those go down only as far as both sides are split
+        ////////////////////////
+        template<voxel_connectivity CONNECT>
+        void component_cell_proc(const component_cell& cell_, component_search& search_)
+        {
+            if(component_leaf(cell_, search_)) {
+                add_leaf_pieces<CONNECT>(cell_, search_);
+                return; }
+
+            std::array<component_cell, 8> children_{};
+            for(uint32_t index_ = 0; index_ < 8; ++index_)
+            {
+                children_[index_] = component_child(cell_, false, index_, search_);
+                if(children_[index_]._node != nullptr) {
+                    component_cell_proc<CONNECT>(children_[index_], search_); }
+            }
+            component_block_proc<CONNECT>(children_, 0x7, 0x7, search_);
+        }
+
+        // the faces along face_axes_ and the edges along edge_axes_ between 2x2x2 cells around a corner,
+        // and the corner itself
+        template<voxel_connectivity CONNECT>
+        void component_block_proc(const std::array<component_cell, 8>& cells_, uint8_t face_axes_, uint8_t edge_axes_, component_search& search_)
+        {
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                if(((face_axes_ >> axis_) & 1u) == 0) {
+                    continue; }
+                for(uint32_t index_ = 0; index_ < 8; ++index_) {
+                    if(((index_ >> axis_) & 1u) == 0) {
+                        component_face_proc<CONNECT>(cells_[index_], cells_[index_ | (1u << axis_)], axis_, search_); } }
+            }
+
+            if constexpr (CONNECT == connect_all)
+            {
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+                {
+                    if(((edge_axes_ >> axis_) & 1u) == 0) {
+                        continue; }
+                    const uint32_t u_ = (axis_ + 1) % 3;
+                    const uint32_t w_ = (axis_ + 2) % 3;
+                    for(uint32_t half_ = 0; half_ < 2; ++half_) {
+                        std::array<component_cell, 4> edge_{};
+                        for(uint32_t k = 0; k < 4; ++k) {
+                            edge_[k] = cells_[(half_ << axis_) | ((k & 1u) << u_) | ((k >> 1) << w_)]; }
+                        component_edge_proc(edge_, axis_, search_); }
+                }
+                component_corner_proc(cells_, search_);
+            }
+        }
+
+        // joins the pieces touching across the face between cell low_ and cell high_ above it along axis_
+        template<voxel_connectivity CONNECT>
+        void component_face_proc(const component_cell& low_, const component_cell& high_, uint32_t axis_, component_search& search_)
+        {
+            if(low_._node == nullptr || high_._node == nullptr) {
+                return; }
+
+            const uint32_t bit_ = 1u << axis_;
+            const bool low_leaf_ = component_leaf(low_, search_);
+            const bool high_leaf_ = component_leaf(high_, search_);
+            if(low_leaf_ && high_leaf_)
+            {
+                if constexpr (CONNECT == connect_all) {
+                    join_pieces(search_._parents,
+                        leaf_piece_in<CONNECT>(low_, side_octants(axis_, true), search_),
+                        leaf_piece_in<CONNECT>(high_, side_octants(axis_, false), search_));
+                } else {
+                    for(uint32_t octant_ = 0; octant_ < 8; ++octant_) {
+                        if((octant_ & bit_) == 0) {
+                            join_pieces(search_._parents,
+                                leaf_piece_in<CONNECT>(low_, static_cast<uint8_t>(1u << (octant_ | bit_)), search_),
+                                leaf_piece_in<CONNECT>(high_, static_cast<uint8_t>(1u << octant_), search_)); } }
+                }
+                return;
+            }
+
+            // the children on both sides of the face around its centre
+            std::array<component_cell, 8> cells_{};
+            for(uint32_t octant_ = 0; octant_ < 8; ++octant_) {
+                cells_[octant_] = (octant_ & bit_) ?
+                    component_child(high_, high_leaf_, octant_ ^ bit_, search_) :
+                    component_child(low_, low_leaf_, octant_ ^ bit_, search_); }
+            component_block_proc<CONNECT>(cells_, static_cast<uint8_t>(bit_), static_cast<uint8_t>(0x7 & ~bit_), search_);
+        }
+
+        // joins the pieces touching only along an edge along axis_, cells_[k] lies on the upper side of
+        // the next axis for k & 1 and on the upper side of the one after for k & 2
+        void component_edge_proc(const std::array<component_cell, 4>& cells_, uint32_t axis_, component_search& search_)
+        {
+            if(!(cells_[0]._node != nullptr && cells_[3]._node != nullptr) &&
+               !(cells_[1]._node != nullptr && cells_[2]._node != nullptr)) {
+                return; }
+
+            const uint32_t u_ = (axis_ + 1) % 3;
+            const uint32_t w_ = (axis_ + 2) % 3;
+            std::array<bool, 4> leaves_{};
+            bool all_leaves_ = true;
+            for(uint32_t k = 0; k < 4; ++k) {
+                leaves_[k] = component_leaf(cells_[k], search_);
+                all_leaves_ = all_leaves_ && leaves_[k]; }
+
+            if(all_leaves_)
+            {
+                std::array<uint32_t, 4> pieces_{};
+                for(uint32_t k = 0; k < 4; ++k) {
+                    const auto octants_ = static_cast<uint8_t>(side_octants(u_, (k & 1u) == 0) & side_octants(w_, (k >> 1) == 0));
+                    pieces_[k] = leaf_piece_in<connect_all>(cells_[k], octants_, search_); }
+                join_pieces(search_._parents, pieces_[0], pieces_[3]);
+                join_pieces(search_._parents, pieces_[1], pieces_[2]);
+                return;
+            }
+
+            // the children along the edge around its middle
+            std::array<component_cell, 8> children_{};
+            for(uint32_t octant_ = 0; octant_ < 8; ++octant_) {
+                const uint32_t k = ((octant_ >> u_) & 1u) | (((octant_ >> w_) & 1u) << 1);
+                children_[octant_] = component_child(cells_[k], leaves_[k], octant_ ^ (1u << u_) ^ (1u << w_), search_); }
+            component_block_proc<connect_all>(children_, 0, static_cast<uint8_t>(1u << axis_), search_);
+        }
+
+        // joins the pieces touching only at the corner that 2x2x2 cells meet at, cells_[octant] lying on its side octant
+        void component_corner_proc(const std::array<component_cell, 8>& cells_, component_search& search_)
+        {
+            bool pairs_ = false;
+            for(uint32_t octant_ = 0; octant_ < 4; ++octant_) {
+                pairs_ = pairs_ || (cells_[octant_]._node != nullptr && cells_[7 - octant_]._node != nullptr); }
+            if(!pairs_) {
+                return; }
+
+            std::array<bool, 8> leaves_{};
+            bool all_leaves_ = true;
+            for(uint32_t octant_ = 0; octant_ < 8; ++octant_) {
+                leaves_[octant_] = component_leaf(cells_[octant_], search_);
+                all_leaves_ = all_leaves_ && leaves_[octant_]; }
+
+            if(all_leaves_)
+            {
+                for(uint32_t octant_ = 0; octant_ < 4; ++octant_) {
+                    join_pieces(search_._parents,
+                        leaf_piece_in<connect_all>(cells_[octant_], static_cast<uint8_t>(1u << (7 - octant_)), search_),
+                        leaf_piece_in<connect_all>(cells_[7 - octant_], static_cast<uint8_t>(1u << octant_), search_)); }
+                return;
+            }
+
+            std::array<component_cell, 8> children_{};
+            for(uint32_t octant_ = 0; octant_ < 8; ++octant_) {
+                children_[octant_] = component_child(cells_[octant_], leaves_[octant_], 7 - octant_, search_); }
+            component_corner_proc(children_, search_);
+        }
+
+        // the piece holding the voxel at position_, NO_PIECE without one
+        template<voxel_connectivity CONNECT>
+        uint32_t anchor_piece(const vector_type& position_, component_search& search_)
+        {
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                if(position_[axis_] < search_._min[axis_] || position_[axis_] > search_._max[axis_]) {
+                    return NO_PIECE; } }
+
+            component_cell cell_{&_root_node, {0, 0, 0}, 0};
+            while(!component_leaf(cell_, search_))
+            {
+                const uint32_t child_size_ = AXIS_WIDTH >> (cell_._depth+1);
+                const uint32_t index_ =
+                    ((position_[0] & child_size_) ? 1u : 0u) |
+                    ((position_[1] & child_size_) ? 2u : 0u) |
+                    ((position_[2] & child_size_) ? 4u : 0u);
+                cell_ = component_child(cell_, false, index_, search_);
+            }
+
+            const uint32_t octant_ = (position_[0] & 1u) | ((position_[1] & 1u) << 1) | ((position_[2] & 1u) << 2);
+            return leaf_piece_in<CONNECT>(cell_, static_cast<uint8_t>(1u << octant_), search_);
+        }
+
+        // reports the voxels in the box with the number of their component, in morton order
+        template<voxel_connectivity CONNECT, bool DETACHED, typename CALLBACK_T>
+        void report_components(const component_cell& cell_, component_search& search_,
+            std::vector<uint32_t>& labels_, uint32_t& count_, CALLBACK_T& callback_)
+        {
+            // components are numbered as they are reached, anchored ones are left out when only detached ones are asked for
+            auto label_of_ = [&](uint32_t piece_) -> uint32_t {
+                const uint32_t root_ = find_piece(search_._parents, piece_);
+                if(DETACHED && search_._anchored[root_]) {
+                    return NO_PIECE; }
+                if(labels_[root_] == NO_PIECE) {
+                    labels_[root_] = count_++; }
+                return labels_[root_];
+            };
+
+            if(!component_leaf(cell_, search_))
+            {
+                for(uint32_t index_ = 0; index_ < 8; ++index_) {
+                    const component_cell child_ = component_child(cell_, false, index_, search_);
+                    if(child_._node != nullptr) {
+                        report_components<CONNECT, DETACHED>(child_, search_, labels_, count_, callback_); } }
+                return;
+            }
+
+            const uint32_t first_ = leaf_piece(*cell_._node, cell_._depth, search_);
+            if(cell_._depth < MAX_DEPTH-1)
+            {
+                const uint32_t label_ = label_of_(first_);
+                if(label_ != NO_PIECE) {
+                    report_subtree(*cell_._node, cell_._origin, cell_._depth, label_, search_, callback_); }
+                return;
+            }
+
+            auto& voxel_block_ = _voxel_pool._blocks[cell_._node->_block_index];
+            const uint8_t voxels_ = component_voxels(cell_, search_);
+            for(uint8_t pending_ = voxels_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1))
+            {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(pending_));
+                const uint32_t label_ = label_of_(first_ + (CONNECT == connect_all ? 0 : util::BLOCK_COMPONENTS._labels[voxels_][index_]));
+                if(label_ == NO_PIECE) {
+                    continue; }
+                const std::array<uint32_t, 3> origin_ = child_origin(cell_._origin, 1, index_);
+                const vector_type position_(origin_[0], origin_[1], origin_[2]);
+                callback_(position_, voxel_block_[index_], label_);
+            }
+        }
+
+        // reports every voxel of a fully occupied subtree inside the box
+        template<typename CALLBACK_T>
+        void report_subtree(const node_format& node_, const std::array<uint32_t, 3>& origin_, uint32_t depth_,
+            uint32_t label_, const component_search& search_, CALLBACK_T& callback_)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                if(node_._uniform)
+                {
+                    // the part of the collapsed extent inside the box, all sharing the one value
+                    const uint32_t size_ = AXIS_WIDTH >> depth_;
+                    std::array<uint32_t, 3> min_{};
+                    std::array<uint32_t, 3> max_{};
+                    for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                        min_[axis_] = util::max<uint32_t>(origin_[axis_], search_._min[axis_]);
+                        max_[axis_] = util::min<uint32_t>(origin_[axis_] + size_ - 1, search_._max[axis_]); }
+
+                    voxel_format& value_ = _voxel_pool._blocks[node_._block_index][0];
+                    for(uint32_t z = min_[2]; z <= max_[2]; ++z) {
+                        for(uint32_t y = min_[1]; y <= max_[1]; ++y) {
+                            for(uint32_t x = min_[0]; x <= max_[0]; ++x) {
+                                const vector_type position_(x, y, z);
+                                callback_(position_, value_, label_); } } }
+                    return;
+                }
+            }
+
+            if(depth_ == MAX_DEPTH-1)
+            {
+                auto& voxel_block_ = _voxel_pool._blocks[node_._block_index];
+                const uint8_t voxels_ = box_children(node_._mask, origin_, 1, search_._min, search_._max);
+                for(uint8_t pending_ = voxels_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) {
+                    const auto index_ = static_cast<uint32_t>(std::countr_zero(pending_));
+                    const std::array<uint32_t, 3> position_origin_ = child_origin(origin_, 1, index_);
+                    const vector_type position_(position_origin_[0], position_origin_[1], position_origin_[2]);
+                    callback_(position_, voxel_block_[index_], label_); }
+                return;
+            }
+
+            const uint32_t child_size_ = AXIS_WIDTH >> (depth_+1);
+            const uint8_t reached_ = box_children(node_._mask, origin_, child_size_, search_._min, search_._max);
+            for(uint8_t pending_ = reached_; pending_ != 0; pending_ &= static_cast<uint8_t>(pending_ - 1)) {
+                const auto index_ = static_cast<uint32_t>(std::countr_zero(pending_));
+                report_subtree(_node_pool._blocks[node_._block_index][index_], child_origin(origin_, child_size_, index_),
+                    depth_+1, label_, search_, callback_); }
+        }
+
+        // releases the blocks of an unlinked node and everything below it, returns the voxels it held
+        uint64_t dealloc_subtree(const node_format& node_, uint32_t depth_)
+        {
+            if constexpr (DETAILS._collapse_uniform) {
+                if(node_._uniform) {
+                    _voxel_pool.dealloc(node_._block_index);
+                    return uint64_t{1} << (3 * (MAX_DEPTH - depth_)); } }
+
+            if(depth_ == MAX_DEPTH-1) {
+                _voxel_pool.dealloc(node_._block_index);
+                return static_cast<uint64_t>(std::popcount(node_._mask)); }
+
+            uint64_t removed_ = 0;
+            for(uint8_t mask_ = node_._mask; mask_ != 0; mask_ &= static_cast<uint8_t>(mask_ - 1)) {
+                removed_ += dealloc_subtree(_node_pool._blocks[node_._block_index][std::countr_zero(mask_)], depth_+1); }
+            _node_pool.dealloc(node_._block_index);
+            return removed_;
+        }
+
+        voxel_format* get_traced_impl(morton_type voxel_morton, node_format** node_path, uint8_t* child_bits, uint8_t* reached_depth)
+        {
+            node_format* node_ = &_root_node;
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-1; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return nullptr;
+                }
+
+                ////////////////////////
+                //        TRACE       //
+                ////////////////////////
+
+                child_bits[i] = child_bit;
+                node_path [i] = node_;
+                *reached_depth = static_cast<uint8_t>(i);
+
+                node_ = &_node_pool._blocks[load_block_index(*node_)][index]; 
+            }
+
+            ////////////////////////
+            //        VOXEL       //
+            ////////////////////////
+
+            SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+            if(!exist)
+            {
+                return nullptr;
+            }
+
+            ////////////////////////
+            //        TRACE       //
+            ////////////////////////
+
+            constexpr auto DEPTH_END =  MAX_DEPTH-1;
+            child_bits [DEPTH_END] = child_bit;
+            node_path  [DEPTH_END] = node_;
+            *reached_depth = DEPTH_END;
+
+            return &_voxel_pool._blocks[load_block_index(*node_)][index];  
+        }
+    };
+
+    template<typename TREE_T>
+    class frozen_tree
+    {
+        friend TREE_T;
+
+    public:
+
+        using voxel_format = TREE_T::voxel_format;
+
+        using morton_type = TREE_T::morton_type;
+
+        using vector_type = TREE_T::vector_type;
+
+        inline static constexpr uint32_t 
+        MAX_DEPTH = TREE_T::MAX_DEPTH;
+
+        inline static constexpr auto
+        BOUNDS = TREE_T::BOUNDS;
+
+        uint64_t byte_size() const
+        {
+            auto size = sizeof(*this);
+            size += _nodes.size()  * sizeof(frozen_node_format);
+            size += _voxels.size() * sizeof(voxel_format);
+            return size;
+        }
+
+        [[nodiscard]] 
+        uint32_t get_node_count() const
+        {
+            return static_cast<uint32_t>(_nodes.size());
+        }
+
+        [[nodiscard]] 
+        uint32_t get_voxel_count() const
+        {
+            return static_cast<uint32_t>(_voxels.size());
+        }
+
+        const voxel_format* get(const vector_type& voxel_position) const
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<TREE_T::get_type()>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_impl(voxel_morton);
+        }
+
+        const voxel_format* get(morton_type voxel_morton) const
+        {
+            const bool overflow = TREE_T::is_overflow(voxel_morton);
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_impl(voxel_morton);
+        }
+
+    private:
+
+        frozen_tree() = default;
+
+        // SVO_NODE_MORTON_CHILD_IMPL reads masks through load_mask
+        static uint8_t load_mask(const frozen_node_format& node_) { return node_.mask(); }
+
+        const voxel_format* get_impl(morton_type voxel_morton) const
+        {
+            // root is always the first node
+            const frozen_node_format* node_ = &_nodes[0];
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-1; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return nullptr;
+                }
+
+                node_ = &_nodes[node_->first_child() + util::popcount8(static_cast<uint8_t>(node_->mask() & (child_bit - 1)))]; 
+            }
+            
+            ////////////////////////
+            //        VOXEL       //
+            ////////////////////////
+            SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+            if(!exist)
+            {
+                return nullptr;
+            }
+
+            return &_voxels[node_->first_child() + util::popcount8(static_cast<uint8_t>(node_->mask() & (child_bit - 1)))];  
+        }
+
+        std::vector<frozen_node_format>
+        _nodes{};
+
+        std::vector<voxel_format>
+        _voxels{};
+    };
+
+    ////////////////////////
+    // read-only tree where equal subtrees are stored once, built bottom-up by tree::to_dag(), 
+    // children are runs of records as in frozen_tree but equal runs are shared, so repeated 
+    // patterns inside one tree and across every tree merged into the same dag_tree cost their 
+    // storage once, each merged tree is a root, get() / for_each_voxel() without one read root 0
+    ////////////////////////
+    template<typename TREE_T>
+    class dag_tree
+    {
+        friend TREE_T;
+
+    public:
+
+        using voxel_format = TREE_T::voxel_format;
+
+        using morton_type = TREE_T::morton_type;
+
+        using vector_type = TREE_T::vector_type;
+
+        inline static constexpr uint32_t 
+        MAX_DEPTH = TREE_T::MAX_DEPTH;
+
+        inline static constexpr auto
+        BOUNDS = TREE_T::BOUNDS;
+
+        // the merge tables count too, release_merge_tables() drops them once nothing more is merged
+        uint64_t byte_size() const
+        {
+            auto size = sizeof(*this);
+            size += _nodes.size()  * sizeof(frozen_node_format);
+            size += _voxels.size() * sizeof(voxel_format);
+            size += _roots.size()  * sizeof(frozen_node_format);
+            size += (_node_slots.size() + _voxel_slots.size()) * sizeof(merge_slot);
+            return size;
+        }
+
+        [[nodiscard]] 
+        uint32_t get_node_count() const
+        {
+            return static_cast<uint32_t>(_nodes.size());
+        }
+
+        [[nodiscard]] 
+        uint32_t get_voxel_count() const
+        {
+            return static_cast<uint32_t>(_voxels.size());
+        }
+
+        [[nodiscard]] 
+        uint32_t get_root_count() const
+        {
+            return static_cast<uint32_t>(_roots.size());
+        }
+
+        // later merges then only share subtrees among themselves
+        void release_merge_tables()
+        {
+            _node_slots = {};
+            _voxel_slots = {};
+            _node_slots_used = 0;
+            _voxel_slots_used = 0;
+        }
+
+        const voxel_format* get(const vector_type& voxel_position, uint32_t root = 0) const
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<TREE_T::get_type()>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_impl(voxel_morton, root);
+        }
+
+        const voxel_format* get(morton_type voxel_morton, uint32_t root = 0) const
+        {
+            const bool overflow = TREE_T::is_overflow(voxel_morton);
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_impl(voxel_morton, root);
+        }
+
+        ////////////////////////
+        // visits every voxel of root in ascending morton order as callback(morton_type morton, 
+        // const voxel_format& voxel), shared subtrees are visited once per occurrence
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void for_each_voxel_morton(CALLBACK_T&& callback, uint32_t root = 0) const
+        {
+            std::array<iterate_frame, MAX_DEPTH> stack_{};
+            stack_[0] = {&_roots[root], 0, _roots[root].mask()};
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                iterate_frame& frame_ = stack_[depth_];
+                if(frame_._pending == 0) 
+                {
+                    if(depth_ == 0) {
+                        return; }
+                    --depth_;
+                    continue;
+                }
+
+                const auto index = static_cast<uint32_t>(std::countr_zero(frame_._pending));
+                frame_._pending &= static_cast<uint8_t>(frame_._pending - 1);
+                const auto morton_ = static_cast<morton_type>((frame_._morton << 3) | index);
+                const uint32_t child_ = frame_._node->first_child() + 
+                    util::popcount8(static_cast<uint8_t>(frame_._node->mask() & ((1u << index) - 1)));
+
+                ////////////////////////
+                //        VOXEL       //
+                ////////////////////////
+                if(depth_ == MAX_DEPTH-1)
+                {
+                    callback(morton_, _voxels[child_]);
+                    continue;
+                }
+
+                stack_[depth_+1] = {&_nodes[child_], morton_, _nodes[child_].mask()};
+                ++depth_;
+            }
+        }
+
+        // same as for_each_voxel_morton with the position decoded, callback(const vector_type& position, const voxel_format& voxel)
+        template<typename CALLBACK_T>
+        void for_each_voxel(CALLBACK_T&& callback, uint32_t root = 0) const
+        {
+            for_each_voxel_morton([&callback](morton_type voxel_morton, const voxel_format& voxel) {
+                vector_type position_{};
+                morton_util<TREE_T::get_type()>::morton_to_pos(voxel_morton, &position_[0]);
+                callback(static_cast<const vector_type&>(position_), voxel);
+            }, root);
+        }
+
+    private:
+
+        struct iterate_frame
+        {
+            const frozen_node_format* 
+            _node{};
+
+            morton_type 
+            _morton{};
+
+            // children still to visit
+            uint8_t 
+            _pending{};
+        };
+
+        // a run of records or voxels already stored, empty slot when _count is 0
+        struct merge_slot
+        {
+            uint64_t 
+            _hash{};
+
+            uint32_t 
+            _offset{};
+
+            uint32_t 
+            _count{};
+        };
+
+        inline static constexpr size_t 
+        MIN_SLOTS = 64;
+
+        // SVO_NODE_MORTON_CHILD_IMPL reads masks through load_mask
+        static uint8_t load_mask(const frozen_node_format& node_) { return node_.mask(); }
+
+        const voxel_format* get_impl(morton_type voxel_morton, uint32_t root) const
+        {
+            const frozen_node_format* node_ = &_roots[root];
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-1; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return nullptr;
+                }
+
+                node_ = &_nodes[node_->first_child() + util::popcount8(static_cast<uint8_t>(node_->mask() & (child_bit - 1)))]; 
+            }
+            
+            ////////////////////////
+            //        VOXEL       //
+            ////////////////////////
+            SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+            if(!exist)
+            {
+                return nullptr;
+            }
+
+            return &_voxels[node_->first_child() + util::popcount8(static_cast<uint8_t>(node_->mask() & (child_bit - 1)))];  
+        }
+
+        uint32_t intern_nodes(const frozen_node_format* run_, uint32_t count_)
+        {
+            // records have no padding, the run is hashed whole
+            const uint64_t hash_ = util::hash_bytes(run_, count_ * sizeof(frozen_node_format), util::hash_bytes(&count_, sizeof(count_)));
+            return intern(_nodes, _node_slots, _node_slots_used, run_, count_, hash_);
+        }
+
+        // voxels are hashed bytewise, voxels equal in value but not in padding only miss a merge
+        uint32_t intern_voxels(const voxel_format* run_, uint32_t count_)
+        {
+            return intern(_voxels, _voxel_slots, _voxel_slots_used, run_, count_, util::hash_bytes(run_, count_ * sizeof(voxel_format)));
+        }
+
+        // offset of the stored run equal to run_, appended to pool_ first if there is none
+        template<typename T>
+        static uint32_t intern(std::vector<T>& pool_, std::vector<merge_slot>& slots_, size_t& used_, const T* run_, uint32_t count_, uint64_t hash_)
+        {
+            // the empty run of a childless root is never read
+            if(count_ == 0) {
+                return 0; }
+
+            // load factor stays at or below 1/2, probe sequences remain short
+            if((used_ + 1) * 2 > slots_.size())
+            {
+                std::vector<merge_slot> grown_(std::max(MIN_SLOTS, slots_.size() * 2));
+                const size_t grown_mask_ = grown_.size() - 1;
+                for(const auto& slot_ : slots_) {
+                    if(slot_._count != 0) {
+                        size_t i = slot_._hash & grown_mask_;
+                        while(grown_[i]._count != 0) {
+                            i = (i + 1) & grown_mask_; }
+                        grown_[i] = slot_;
+                    }
+                }
+                slots_.swap(grown_);
+            }
+
+            const size_t mask_ = slots_.size() - 1;
+            size_t i = hash_ & mask_;
+            for(; slots_[i]._count != 0; i = (i + 1) & mask_) 
+            {
+                const merge_slot& slot_ = slots_[i];
+                if(slot_._hash == hash_ && slot_._count == count_ && std::equal(run_, run_ + count_, pool_.begin() + slot_._offset)) {
+                    return slot_._offset; }
+            }
+
+            const auto offset_ = static_cast<uint32_t>(pool_.size());
+            pool_.insert(pool_.end(), run_, run_ + count_);
+            slots_[i] = {hash_, offset_, count_};
+            ++used_;
+            return offset_;
+        }
+
+        std::vector<frozen_node_format>
+        _nodes{};
+
+        std::vector<voxel_format>
+        _voxels{};
+
+        // the root record of every merged tree
+        std::vector<frozen_node_format>
+        _roots{};
+
+        std::vector<merge_slot>
+        _node_slots{};
+
+        std::vector<merge_slot>
+        _voxel_slots{};
+
+        size_t 
+        _node_slots_used{};
+
+        size_t 
+        _voxel_slots_used{};
+    };
+
+    ////////////////////////
+    // read-only zero-copy view of a tree::save() snapshot, the file is mapped and get() walks
+    // the mapped blocks in place so opening costs no parsing, only the header is validated
+    ////////////////////////
+    template<typename TREE_T>
+    class tree_view
+    {
+    public:
+
+        using voxel_format = TREE_T::voxel_format;
+
+        using morton_type = TREE_T::morton_type;
+
+        using vector_type = TREE_T::vector_type;
+
+        inline static constexpr uint32_t 
+        MAX_DEPTH = TREE_T::MAX_DEPTH;
+
+        inline static constexpr auto
+        BOUNDS = TREE_T::BOUNDS;
+
+        tree_view() = default;
+        tree_view(const tree_view&) = delete;
+        tree_view& operator=(const tree_view&) = delete;
+
+        tree_view(tree_view&& other_) noexcept { *this = std::move(other_); }
+
+        tree_view& operator=(tree_view&& other_) noexcept 
+        {
+            if(this != &other_) 
+            {
+                _file         = std::move(other_._file);
+                _root_node    = std::exchange(other_._root_node, {});
+                _nodes        = std::exchange(other_._nodes, nullptr);
+                _voxels       = std::exchange(other_._voxels, nullptr);
+                _node_blocks  = std::exchange(other_._node_blocks, 0);
+                _voxel_blocks = std::exchange(other_._voxel_blocks, 0);
+            }
+            return *this;
+        }
+
+        // false if the file is missing, truncated or was saved by a different tree type, node 
+        // block indices pointing past the mapped regions are caught by get() instead
+        [[nodiscard]] 
+        bool open(const char* path)
+        {
+            static_assert(std::endian::native == std::endian::little, "snapshots are little-endian");
+            static_assert(std::is_trivially_copyable_v<voxel_format>, "snapshots copy voxels bytewise");
+
+            close();
+            if(!_file.open(path)) {
+                return false; }
+
+            snapshot_header header_{};
+            if(_file.size() < sizeof(header_)) {
+                close();
+                return false; }
+
+            std::memcpy(&header_, _file.data(), sizeof(header_));
+
+            const uint64_t node_bytes_  = uint64_t{header_._node_blocks}  * 8 * sizeof(snapshot_node_format);
+            const uint64_t voxel_bytes_ = uint64_t{header_._voxel_blocks} * 8 * sizeof(voxel_format);
+
+            const bool valid_ = 
+                header_._magic      == snapshot_header::MAGIC &&
+                header_._version    == snapshot_header::VERSION &&
+                header_._bit_width  == static_cast<uint32_t>(TREE_T::get_type()) &&
+                header_._max_depth  == MAX_DEPTH &&
+                header_._voxel_size == sizeof(voxel_format) &&
+                header_._bounds     == BOUNDS &&
+                header_._root_mask  <= 0xFF &&
+                header_._node_blocks > 0 &&
+                header_._node_offset  % 64 == 0 && header_._node_offset  >= sizeof(header_) &&
+                header_._voxel_offset % 64 == 0 && header_._voxel_offset >= header_._node_offset &&
+                // each region on its own, so huge offsets cannot wrap around
+                header_._voxel_offset <= _file.size() && voxel_bytes_ <= _file.size() - header_._voxel_offset &&
+                node_bytes_ <= header_._voxel_offset - header_._node_offset;
+
+            if(!valid_) {
+                close();
+                return false; }
+
+            _root_node = {0, 0, static_cast<uint8_t>(header_._root_mask), 0};
+            _nodes        = reinterpret_cast<const snapshot_node_format*>(_file.data() + header_._node_offset);
+            _voxels       = reinterpret_cast<const voxel_format*>(_file.data() + header_._voxel_offset);
+            _node_blocks  = header_._node_blocks;
+            _voxel_blocks = header_._voxel_blocks;
+            return true;
+        }
+
+        void close()
+        {
+            _file.close();
+            _root_node    = {};
+            _nodes        = nullptr;
+            _voxels       = nullptr;
+            _node_blocks  = 0;
+            _voxel_blocks = 0;
+        }
+
+        [[nodiscard]] 
+        bool is_open() const { return _nodes != nullptr; }
+
+        [[nodiscard]] 
+        uint32_t get_node_blocks_count() const { return _node_blocks; }
+
+        [[nodiscard]] 
+        uint32_t get_voxel_blocks_count() const { return _voxel_blocks; }
+
+        const voxel_format* get(const vector_type& voxel_position) const
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<TREE_T::get_type()>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_impl(voxel_morton);
+        }
+
+        const voxel_format* get(morton_type voxel_morton) const
+        {
+            const bool overflow = TREE_T::is_overflow(voxel_morton);
+
+            if constexpr (TREE_T::details()._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_impl(voxel_morton);
+        }
+
+    private:
+
+        // SVO_NODE_MORTON_CHILD_IMPL reads masks through load_mask
+        static uint8_t load_mask(const snapshot_node_format& node_) { return node_._mask; }
+
+        // block indices come from the file, one out of range reads as a missing voxel
+        const voxel_format* get_impl(morton_type voxel_morton) const
+        {
+            // an unopened view has an empty root
+            const snapshot_node_format* node_ = &_root_node;
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < MAX_DEPTH-1; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist || node_->_block_index >= _node_blocks){
+                    return nullptr;
+                }
+
+                node_ = &_nodes[size_t{node_->_block_index} * 8 + index]; 
+            }
+            
+            ////////////////////////
+            //        VOXEL       //
+            ////////////////////////
+            SVO_NODE_MORTON_CHILD_IMPL(MAX_DEPTH-1);
+
+            if(!exist || node_->_block_index >= _voxel_blocks)
+            {
+                return nullptr;
+            }
+
+            return &_voxels[size_t{node_->_block_index} * 8 + index];  
+        }
+
+        util::mapped_file
+        _file{};
+
+        snapshot_node_format
+        _root_node{};
+
+        const snapshot_node_format*
+        _nodes{};
+
+        const voxel_format*
+        _voxels{};
+
+        uint32_t
+        _node_blocks{};
+
+        uint32_t
+        _voxel_blocks{};
+    };
+
+    ////////////////////////
+    // tree whose leaves are dense bricks of BRICK_EXTENT^3 voxels with an occupancy bitmask, where 
+    // tree has a level of nodes over 2^3 voxel blocks, a brick spans BRICK_LEVELS morton levels so 
+    // get() walks BRICK_LEVELS - 1 levels less and dense regions drop the node blocks of those levels, 
+    // brick voxels are laid out in morton order, a brick is allocated whole on its first voxel so 
+    // scattered voxels are better served by tree, BRICK_LEVELS 1 is tree's own leaf layout
+    ////////////////////////
+    template<bit_width BIT_WIDTH, typename FORMAT_T = basic_voxel_format, details_info DETAILS = {}, uint32_t BRICK_LEVELS = 2>
+    class brick_tree
+    {
+    public:
+
+        using tree_type = tree<BIT_WIDTH, FORMAT_T, DETAILS>;
+
+        using voxel_format = FORMAT_T;
+
+        using spatial_voxel = tree_type::spatial_voxel;
+
+        using component_type = tree_type::component_type;
+
+        using morton_type = tree_type::morton_type;
+
+        using vector_type = tree_type::vector_type;
+
         inline static constexpr uint32_t 
-        MAX_DEPTH = calc_bounds_max_depth(); 
-        
-        inline static constexpr uint32_t 
-        AXIS_WIDTH = 1 << MAX_DEPTH;
-       
+        MAX_DEPTH = tree_type::MAX_DEPTH;
+
+        inline static constexpr auto
+        BOUNDS = tree_type::BOUNDS;
+
         inline static constexpr uint32_t 
-        MAX_SIZE = 
-            AXIS_WIDTH*
-            AXIS_WIDTH*
-            AXIS_WIDTH; 
-        ////////////////////////
-        
-        [[nodiscard]] 
-        static constexpr bit_width get_type() { return BIT_WIDTH; }
+        AXIS_WIDTH = tree_type::AXIS_WIDTH;
 
-        using voxel_format = FORMAT_T;
+        inline static constexpr uint32_t 
+        BRICK_EXTENT = 1u << BRICK_LEVELS;
 
-        using spatial_node = spatial<node_format, BIT_WIDTH>;
+        inline static constexpr uint32_t 
+        BRICK_VOXELS = 1u << (3 * BRICK_LEVELS);
 
-        using spatial_voxel = spatial<voxel_format, BIT_WIDTH>;
-        
-        using component_type = morton_util<BIT_WIDTH>::component_type;
+        // nodes at BRICK_DEPTH own a brick instead of a node block
+        inline static constexpr uint32_t 
+        BRICK_DEPTH = MAX_DEPTH - BRICK_LEVELS;
 
-        using signed_component_type = morton_util<BIT_WIDTH>::signed_component_type;
-        
-        using vector_type = glm::vec<3, component_type>;
-    
-    private:
+        static_assert(BRICK_LEVELS >= 1 && BRICK_LEVELS <= 3, "bricks are 2^3, 4^3 or 8^3 voxels");
+        static_assert(MAX_DEPTH > BRICK_LEVELS, "the bounds must be larger than a brick");
+        static_assert(!DETAILS._concurrent && !DETAILS._track_dirty && !DETAILS._collapse_uniform, 
+            "brick_tree has no concurrent mode, dirty tracking or collapsing");
 
-        node_format
-        _root_node{};
+        struct brick_format
+        {
+            std::array<uint64_t, (BRICK_VOXELS + 63) / 64>
+            _occupancy{};
 
-        mem_pool<node_format>
-        _node_pool{};
+            std::array<voxel_format, BRICK_VOXELS>
+            _voxels{};
 
-        mem_pool<voxel_format>
-        _voxel_pool{};
+            [[nodiscard]] 
+            bool test(uint32_t index_) const {
+                return (_occupancy[index_ >> 6] >> (index_ & 63u)) & 1u;
+            }
 
-    public:
+            [[nodiscard]] 
+            bool empty() const 
+            {
+                uint64_t any_ = 0;
+                for(const uint64_t word_ : _occupancy) {
+                    any_ |= word_; }
+                return any_ == 0;
+            }
+        };
 
-        tree()
+        brick_tree()
         {
             _root_node = {};
             _root_node._depth = 0;
             _root_node._block_index = _node_pool.alloc();
         }
 
+        uint64_t byte_size() const
+        {
+            auto size = sizeof(*this);
+            size += uint64_t{get_node_blocks_count()} * sizeof(node_format) * 8;
+            size += uint64_t{get_brick_count()} * sizeof(brick_format);
+            return size;
+        }
+
         [[nodiscard]] 
         uint32_t get_node_blocks_count() const
         {
-            return static_cast<uint32_t>(_node_pool._blocks.size() - _node_pool._free.size());
+            return _node_pool.used_count();
         }
-        
+
         [[nodiscard]] 
-        uint32_t get_voxel_blocks_count() const
+        uint32_t get_brick_count() const
+        {
+            return _brick_pool.used_count();
+        }
+
+        // sorted by brick, every brick is walked to once
+        void alloc_bulk(spatial_voxel* voxels, uint32_t count)
+        {
+            constexpr uint32_t BRICK_SHIFT = 3 * BRICK_LEVELS;
+
+            std::vector<util::sort_entry<morton_type>> sorted_{};
+            sorted_.reserve(count);
+
+            bool is_sorted_ = true;
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                const morton_type morton_ = voxels[i]._morton;
+                const bool overflow = tree_type::is_overflow(morton_);
+
+                if constexpr (DETAILS._discard_overflow){   
+                    if(overflow) { continue; } 
+                } else {
+                    assert(!overflow);
+                }
+
+                is_sorted_ &= sorted_.empty() || (sorted_.back()._key >> BRICK_SHIFT) <= (morton_ >> BRICK_SHIFT);
+                sorted_.push_back({morton_, i});
+            }
+
+            // stable, a later duplicate still overwrites an earlier one
+            if(!is_sorted_) {
+                util::radix_sort(sorted_, 3 * BRICK_DEPTH, BRICK_SHIFT);
+            }
+
+            brick_format* brick_ = nullptr;
+            morton_type brick_prefix_{};
+            for(const auto& entry_ : sorted_)
+            {
+                // only a new brick relocates the brick pool
+                const auto prefix_ = static_cast<morton_type>(entry_._key >> BRICK_SHIFT);
+                if(brick_ == nullptr || prefix_ != brick_prefix_) {
+                    brick_ = &brick_of(entry_._key);
+                    brick_prefix_ = prefix_;
+                }
+
+                const uint32_t index_ = static_cast<uint32_t>(entry_._key) & (BRICK_VOXELS - 1);
+                brick_->_occupancy[index_ >> 6] |= uint64_t{1} << (index_ & 63u);
+                brick_->_voxels[index_] = voxels[entry_._index]._data;
+            }
+        }
+
+        void alloc(vector_type& voxel_position, voxel_format& voxel)
+        { 
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            alloc_impl(voxel_morton, voxel);
+        }
+
+        void alloc(morton_type voxel_morton, voxel_format& voxel)
+        { 
+            const bool overflow = tree_type::is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return; } 
+            } else {
+                assert(!overflow);
+            }
+
+            alloc_impl(voxel_morton, voxel);
+        }
+
+        voxel_format* get(const vector_type& voxel_position)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return get_impl(voxel_morton);
+        }
+
+        voxel_format* get(morton_type voxel_morton)
+        {
+            const bool overflow = tree_type::is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return nullptr; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return get_impl(voxel_morton);
+        }
+
+        bool dealloc(const vector_type& voxel_position)
+        {
+            const bool overflow = 
+            voxel_position[0] >= BOUNDS[0] || 
+            voxel_position[1] >= BOUNDS[1] || 
+            voxel_position[2] >= BOUNDS[2]; 
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            morton_type voxel_morton{};
+            morton_util<BIT_WIDTH>::pos_to_morton(voxel_morton, &voxel_position[0]);
+            return dealloc_impl(voxel_morton);
+        }
+
+        bool dealloc(morton_type voxel_morton)
+        {
+            const bool overflow = tree_type::is_overflow(voxel_morton);
+
+            if constexpr (DETAILS._discard_overflow){   
+                if(overflow) { return false; } 
+            } else {
+                assert(!overflow);
+            }
+
+            return dealloc_impl(voxel_morton);
+        }
+
+        ////////////////////////
+        // visits every voxel in ascending morton order as callback(morton_type morton, voxel_format& voxel), 
+        // depth-first over occupied children and then over the occupancy bits of each brick
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void for_each_voxel_morton(CALLBACK_T&& callback)
+        {
+            std::array<iterate_frame, BRICK_DEPTH> stack_{};
+            stack_[0] = {&_root_node, 0, _root_node._mask};
+
+            uint32_t depth_ = 0;
+            while(true)
+            {
+                iterate_frame& frame_ = stack_[depth_];
+                if(frame_._pending == 0) 
+                {
+                    if(depth_ == 0) {
+                        return; }
+                    --depth_;
+                    continue;
+                }
+
+                const auto index = static_cast<uint32_t>(std::countr_zero(frame_._pending));
+                frame_._pending &= static_cast<uint8_t>(frame_._pending - 1);
+                const auto morton_ = static_cast<morton_type>((frame_._morton << 3) | index);
+                const node_format* child_ = &_node_pool._blocks[frame_._node->_block_index][index];
+
+                if(depth_ < BRICK_DEPTH-1)
+                {
+                    stack_[depth_+1] = {child_, morton_, child_->_mask};
+                    ++depth_;
+                    continue;
+                }
+
+                ////////////////////////
+                //        BRICK       //
+                ////////////////////////
+                auto& brick_ = _brick_pool._blocks[child_->_block_index][0];
+                for(uint32_t word_ = 0; word_ < brick_._occupancy.size(); ++word_) {
+                    for(uint64_t bits_ = brick_._occupancy[word_]; bits_ != 0; bits_ &= bits_ - 1) 
+                    {
+                        const uint32_t voxel_ = word_ * 64 + static_cast<uint32_t>(std::countr_zero(bits_));
+                        callback(static_cast<morton_type>((morton_ << (3 * BRICK_LEVELS)) | voxel_), brick_._voxels[voxel_]);
+                    }
+                }
+            }
+        }
+
+        // same as for_each_voxel_morton with the position decoded, callback(const vector_type& position, voxel_format& voxel)
+        template<typename CALLBACK_T>
+        void for_each_voxel(CALLBACK_T&& callback)
+        {
+            for_each_voxel_morton([&callback](morton_type voxel_morton, voxel_format& voxel) {
+                vector_type position_{};
+                morton_util<BIT_WIDTH>::morton_to_pos(voxel_morton, &position_[0]);
+                callback(static_cast<const vector_type&>(position_), voxel);
+            });
+        }
+
+    private:
+
+        struct iterate_frame
+        {
+            const node_format* 
+            _node{};
+
+            morton_type 
+            _morton{};
+
+            // children still to visit
+            uint8_t 
+            _pending{};
+        };
+
+        // SVO_NODE_MORTON_CHILD_IMPL reads masks through load_mask
+        static uint8_t load_mask(const node_format& node_) { return node_._mask; }
+
+        // brick holding voxel_morton, the path down to it is created as needed
+        brick_format& brick_of(morton_type voxel_morton)
+        {
+            node_format* node_ = &_root_node;
+
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < BRICK_DEPTH; ++i)
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                // read before alloc, the node pool can relocate under node_
+                const uint32_t node_block_index = node_->_block_index;
+
+                if(!exist)
+                {
+                    node_->_mask |= child_bit;
+
+                    node_format new_node_{};
+                    new_node_._depth = static_cast<uint8_t>(i+1);
+                    new_node_._mask  = 0;
+                    if(i+1 < BRICK_DEPTH) {
+                        new_node_._block_index = _node_pool.alloc();
+                    } else {
+                        // a reused brick still holds its old occupancy
+                        new_node_._block_index = _brick_pool.alloc();
+                        _brick_pool._blocks[new_node_._block_index][0]._occupancy = {};
+                    }
+                    _node_pool._blocks[node_block_index][index] = new_node_;
+                }
+
+                node_ = &_node_pool._blocks[node_block_index][index];
+            }
+
+            return _brick_pool._blocks[node_->_block_index][0];
+        }
+
+        void alloc_impl(morton_type voxel_morton, voxel_format& voxel)
+        {
+            brick_format& brick_ = brick_of(voxel_morton);
+            const uint32_t index_ = static_cast<uint32_t>(voxel_morton) & (BRICK_VOXELS - 1);
+            brick_._occupancy[index_ >> 6] |= uint64_t{1} << (index_ & 63u);
+            brick_._voxels[index_] = voxel;
+        }
+
+        voxel_format* get_impl(morton_type voxel_morton)
+        {
+            const node_format* node_ = &_root_node;
+
+            ////////////////////////
+            // TRAVERSE NODE TREE //
+            ////////////////////////
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < BRICK_DEPTH; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return nullptr;
+                }
+
+                node_ = &_node_pool._blocks[node_->_block_index][index]; 
+            }
+
+            ////////////////////////
+            //        BRICK       //
+            ////////////////////////
+            auto& brick_ = _brick_pool._blocks[node_->_block_index][0];
+            const uint32_t index_ = static_cast<uint32_t>(voxel_morton) & (BRICK_VOXELS - 1);
+            return brick_.test(index_) ? &brick_._voxels[index_] : nullptr;
+        }
+
+        bool dealloc_impl(morton_type voxel_morton)
         {
-            return static_cast<uint32_t>(_voxel_pool._blocks.size() - _voxel_pool._free.size());
+            std::array<node_format*, BRICK_DEPTH + 1> path_{};
+            std::array<uint8_t, BRICK_DEPTH> child_bits_{};
+            node_format* node_ = &_root_node;
+
+            LOOP_UNROLL
+            for(uint32_t i = 0; i < BRICK_DEPTH; ++i) 
+            {
+                SVO_NODE_MORTON_CHILD_IMPL(i);
+
+                if(!exist){
+                    return false;
+                }
+
+                path_[i] = node_;
+                child_bits_[i] = child_bit;
+                node_ = &_node_pool._blocks[node_->_block_index][index]; 
+            }
+            path_[BRICK_DEPTH] = node_;
+
+            auto& brick_ = _brick_pool._blocks[node_->_block_index][0];
+            const uint32_t index_ = static_cast<uint32_t>(voxel_morton) & (BRICK_VOXELS - 1);
+            if(!brick_.test(index_)) {
+                return false; }
+
+            brick_._occupancy[index_ >> 6] &= ~(uint64_t{1} << (index_ & 63u));
+            if(!brick_.empty()) {
+                return true; }
+
+            // # if we got here, we can dealloc the brick and every node left without children
+            _brick_pool.dealloc(node_->_block_index);
+
+            // traverse up, root node excluded
+            for(uint32_t depth_ = BRICK_DEPTH; depth_ >= 1; --depth_)
+            {
+                node_format* parent_ = path_[depth_-1];
+                parent_->_mask &= static_cast<uint8_t>(~child_bits_[depth_-1]);
+                if(depth_-1 == 0 || parent_->_mask != 0) {
+                    break; }
+                _node_pool.dealloc(parent_->_block_index);
+            }
+
+            return true;
         }
 
-        void alloc_bulk(spatial_voxel* voxels, uint32_t count)
-        {
-            // would prefer to pre-alloc blocks, but the estimation can't be get right without proper 
-            // voxel array spatial analysis and we ofc cant do that as it can potentially 
-            // decrease performance in orders of magnitude.
-            // Also, over estimating block counts even a bit will most of the time just
-            // decrease performance (benchmarked on my own PC, specs info in documents), 
-            // std::vector default allocation strategy seems to be the most consistent,
-            // and generally the most optimal to rely on with bulk allocs for now
-            for(uint32_t i = 0; i < count; ++i){
-                vector_type pos{0,0,0}; 
-                voxels[i].decode_position(&pos[0]);
-                alloc(pos, voxels[i]._data);
-            }
-        }
+        node_format 
+        _root_node{};
+
+        mem_pool<node_format>
+        _node_pool{};
+
+        mem_pool<brick_format, 1>
+        _brick_pool{};
+    };
+
+    ////////////////////////
+    // unbounded voxel space tiled with TREE_T chunks, chunk c covers the world positions
+    // [c * BOUNDS, (c + 1) * BOUNDS), chunks live in an open addressing table with linear
+    // probing and the chunk of the last lookup is cached since access is mostly coherent
+    ////////////////////////
+    template<typename TREE_T>
+    class world
+    {
+    public:
 
-        void alloc(vector_type& voxel_position, voxel_format& voxel)
-        { 
-            const bool overflow = 
-            voxel_position[0] >= BOUNDS[0] || 
-            voxel_position[1] >= BOUNDS[1] || 
-            voxel_position[2] >= BOUNDS[2]; 
+        using tree_type = TREE_T;
 
-            if constexpr (DETAILS._discard_overflow){   
-                if(overflow) { return; } 
-            } else {
-                assert(!overflow);
-            }
+        using voxel_format = TREE_T::voxel_format;
 
-            vector_type voxel_transformed; 
+        using vector_type = TREE_T::vector_type;
 
-            // x2 even space
-            voxel_transformed = voxel_position;
-            voxel_transformed <<= 1; 
-            
-            node_format* node_ = &_root_node;
-        
-            // root node origin is always zero
-            vector_type node_position{0,0,0}; 
-            
-            auto node_block_index = 0;
+        using component_type = TREE_T::component_type;
 
-            ////////////////////////
-            // TRAVERSE NODE TREE //
-            ////////////////////////            
-            // not tested with MSVC, with Clang on windows getting ~2x performance (my PC with 32^3 alloc benchmark, ~1.6m ns -> ~800k ns) 
-            // improvement from succesful unrolling for this specific traversing loop, this indicates signifigant overhead is caused by 
-            // branching and pipeline stalls
-            LOOP_UNROLL
-            for(int i = 0; i < MAX_DEPTH-2; ++i)
-            {
-                const auto depth_ = i;
+        using chunk_coord = glm::ivec3;
 
-                const auto node_extent = (component_type)(AXIS_WIDTH >> depth_);
+        using world_position = glm::ivec3;
 
-                SVO_NODE_RELATION_MATH_IMPL();
+        // fills in a freshly created empty chunk, e.g. generates it or reads it from disk
+        using load_hook = std::function<void(const chunk_coord&, tree_type&)>;
 
-                node_->_mask |= child_bit;
+        // last look at a chunk before unload_chunk() destroys it
+        using unload_hook = std::function<void(const chunk_coord&, tree_type&)>;
 
-                node_block_index = node_->_block_index;
-                auto& node_block_ = _node_pool._blocks[node_block_index];
-        
-                if(!exist)
-                {   
-                    node_format new_node_{};
-                    new_node_._depth = depth_+1;
-                    new_node_._mask  = 0;
-                    new_node_._block_index = _node_pool.acquire_next_index();
-                    node_block_[index] = new_node_;
+        inline static constexpr std::array<int32_t, 3>
+        CHUNK_EXTENT = {TREE_T::BOUNDS[0], TREE_T::BOUNDS[1], TREE_T::BOUNDS[2]};
 
-                    _node_pool.alloc();
+        struct raycast_hit
+        {
+            // nullptr when nothing was hit within max distance
+            voxel_format*
+            _voxel{};
 
-                    node_ = &_node_pool._blocks[node_block_index][index]; 
-                } 
-                else 
-                {
-                    node_ = &node_block_[index]; 
-                }
+            world_position
+            _position{};
 
-                node_position = next_node_position;
-            }
+            voxel_face
+            _face{face_none};
 
-            ////////////////////////
-            //    VOXEL OCTANT    //
-            ////////////////////////
-            {
-                auto node_extent = (component_type)(4);
+            float
+            _distance{};
+        };
 
-                SVO_NODE_RELATION_MATH_IMPL();
+        void set_load_hook(load_hook hook)
+        {
+            _load_hook = std::move(hook);
+        }
 
-                node_->_mask |= child_bit;
-                auto& node_block_ = _node_pool._blocks[node_->_block_index];
+        void set_unload_hook(unload_hook hook)
+        {
+            _unload_hook = std::move(hook);
+        }
 
-                if(!exist)
-                {
-                    node_format new_node_{};
-                    new_node_._depth = MAX_DEPTH-1;
-                    new_node_._mask  = 0;
-                    // this time acquire voxel block index from voxel_pool
-                    new_node_._block_index = _voxel_pool.acquire_next_index();
-                    
-                    node_block_[index] = new_node_;
+        [[nodiscard]]
+        static chunk_coord chunk_of(const world_position& position)
+        {
+            return {
+                util::floor_div(position[0], CHUNK_EXTENT[0]),
+                util::floor_div(position[1], CHUNK_EXTENT[1]),
+                util::floor_div(position[2], CHUNK_EXTENT[2])};
+        }
 
-                    // alloc new voxel block
-                    _voxel_pool.alloc();
+        [[nodiscard]]
+        static world_position chunk_origin(const chunk_coord& chunk)
+        {
+            return {chunk[0] * CHUNK_EXTENT[0], chunk[1] * CHUNK_EXTENT[1], chunk[2] * CHUNK_EXTENT[2]};
+        }
 
-                    node_ = &node_block_[index]; 
-                } 
-                else 
-                {
-                    node_ = &node_block_[index];
-                }
-                node_position = next_node_position;
-            }
+        [[nodiscard]]
+        size_t get_chunk_count() const
+        {
+            return _count;
+        }
 
-            ////////////////////////
-            //     ALLOC VOXEL    //
-            ////////////////////////
-            {
-                auto node_extent = (component_type)(2);
+        // nullptr when the chunk is not loaded
+        [[nodiscard]]
+        tree_type* find_chunk(const chunk_coord& chunk)
+        {
+            if(_cached_chunk != nullptr && _cached_coord == chunk) {
+                return _cached_chunk; }
+            if(_count == 0) {
+                return nullptr; }
+
+            auto& slot_ = _slots[slot_of(chunk)];
+            if(!slot_._chunk) {
+                return nullptr; }
+
+            _cached_coord = chunk;
+            _cached_chunk = slot_._chunk.get();
+            return _cached_chunk;
+        }
 
-                SVO_NODE_RELATION_MATH_IMPL();
+        // creates the chunk and runs the load hook on it unless it is loaded already
+        tree_type& load_chunk(const chunk_coord& chunk)
+        {
+            if(tree_type* tree_ = find_chunk(chunk)) {
+                return *tree_; }
 
-                node_->_mask |= child_bit;
+            tree_type& tree_ = insert(chunk, std::make_unique<tree_type>());
+            if(_load_hook) {
+                _load_hook(chunk, tree_); }
+            return tree_;
+        }
 
-                auto& voxel_block_ = _voxel_pool._blocks[node_->_block_index];
-                
-                // allocate voxel
-                voxel_block_[index] = voxel;
-            }
+        // runs the unload hook and destroys the chunk, false when it was not loaded
+        bool unload_chunk(const chunk_coord& chunk)
+        {
+            std::unique_ptr<tree_type> tree_ = detach_chunk(chunk);
+            if(!tree_) {
+                return false; }
+            if(_unload_hook) {
+                _unload_hook(chunk, *tree_); }
+            return true;
         }
 
-        voxel_format* get(const vector_type& voxel_position)
+        ////////////////////////
+        // attach / detach move chunks in and out without running the hooks, so chunks can be
+        // generated or saved on other threads while the world keeps being used, attaching over
+        // a loaded chunk unloads that one first
+        ////////////////////////
+        tree_type& attach_chunk(const chunk_coord& chunk, std::unique_ptr<tree_type> tree)
         {
-            const bool overflow = 
-            voxel_position[0] >= BOUNDS[0] || 
-            voxel_position[1] >= BOUNDS[1] || 
-            voxel_position[2] >= BOUNDS[2]; 
+            assert(tree);
+            unload_chunk(chunk);
+            return insert(chunk, std::move(tree));
+        }
 
-            if constexpr (DETAILS._discard_overflow){   
-                if(overflow) { return nullptr; } 
-            } else {
-                assert(!overflow);
+        std::unique_ptr<tree_type> detach_chunk(const chunk_coord& chunk)
+        {
+            if(_count == 0) {
+                return nullptr; }
+
+            const size_t mask_ = _slots.size() - 1;
+            size_t hole_ = slot_of(chunk);
+            std::unique_ptr<tree_type> tree_ = std::move(_slots[hole_]._chunk);
+            if(!tree_) {
+                return nullptr; }
+
+            // backward shift, entries after the hole move into it unless that would put them
+            // in front of their home slot
+            for(size_t i = (hole_ + 1) & mask_; _slots[i]._chunk; i = (i + 1) & mask_)
+            {
+                const size_t home_ = hash(_slots[i]._coord) & mask_;
+                if(((i - home_) & mask_) >= ((i - hole_) & mask_)) {
+                    _slots[hole_] = std::move(_slots[i]);
+                    hole_ = i;
+                }
             }
 
-            vector_type voxel_transformed; 
+            --_count;
+            _bounds_stale = true;
+            if(_cached_chunk == tree_.get()) {
+                _cached_chunk = nullptr; }
+            return tree_;
+        }
 
-            // x2 even space
-            voxel_transformed = voxel_position;
-            voxel_transformed *= 2; 
-            
-            node_format* node_ = &_root_node;
-        
-            // root node origin is always zero
-            vector_type node_position{0,0,0}; 
+        // callback(const chunk_coord& chunk, tree_type& tree) for every loaded chunk
+        template<typename CALLBACK_T>
+        void for_each_chunk(CALLBACK_T&& callback)
+        {
+            for(auto& slot_ : _slots) {
+                if(slot_._chunk) {
+                    callback(static_cast<const chunk_coord&>(slot_._coord), *slot_._chunk); }
+            }
+        }
 
-            ////////////////////////
-            // TRAVERSE NODE TREE //
-            ////////////////////////
+        voxel_format* get(const world_position& voxel_position)
+        {
+            const chunk_coord chunk_ = chunk_of(voxel_position);
+            tree_type* tree_ = find_chunk(chunk_);
+            if(tree_ == nullptr) {
+                return nullptr; }
+            return tree_->get(local_position(voxel_position, chunk_));
+        }
 
-            LOOP_UNROLL
-            for(int i = 0; i < MAX_DEPTH-1; ++i) 
-            {
-                const auto depth_ = i;
+        // loads the chunk of voxel_position when needed
+        void alloc(const world_position& voxel_position, voxel_format& voxel)
+        {
+            const chunk_coord chunk_ = chunk_of(voxel_position);
+            vector_type local_ = local_position(voxel_position, chunk_);
+            load_chunk(chunk_).alloc(local_, voxel);
+        }
 
-                const auto node_extent = (component_type)(AXIS_WIDTH >> depth_);
+        bool dealloc(const world_position& voxel_position)
+        {
+            const chunk_coord chunk_ = chunk_of(voxel_position);
+            tree_type* tree_ = find_chunk(chunk_);
+            if(tree_ == nullptr) {
+                return false; }
+            return tree_->dealloc(local_position(voxel_position, chunk_));
+        }
 
-                SVO_NODE_RELATION_MATH_IMPL();
+        ////////////////////////
+        // tree::for_each_in_box on every loaded chunk the inclusive box touches, chunk by chunk,
+        // as callback(const world_position& position, voxel_format& voxel)
+        ////////////////////////
+        template<typename CALLBACK_T>
+        void for_each_in_box(const world_position& box_min, const world_position& box_max, CALLBACK_T&& callback)
+        {
+            if(box_min[0] > box_max[0] || box_min[1] > box_max[1] || box_min[2] > box_max[2]) {
+                return; }
 
-                if(!exist){
-                    return nullptr;
-                }
+            const chunk_coord first_ = chunk_of(box_min);
+            const chunk_coord last_  = chunk_of(box_max);
 
-                auto& node_block_ = _node_pool._blocks[node_->_block_index];
-                node_ = &node_block_[index]; 
-                node_position = next_node_position;
+            auto visit_ = [&](const chunk_coord& chunk_, tree_type& tree_)
+            {
+                const world_position origin_ = chunk_origin(chunk_);
+                vector_type min_{};
+                vector_type max_{};
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    min_[axis_] = static_cast<component_type>(std::max(box_min[axis_] - origin_[axis_], 0));
+                    max_[axis_] = static_cast<component_type>(std::min(box_max[axis_] - origin_[axis_], CHUNK_EXTENT[axis_] - 1));
+                }
+                tree_.for_each_in_box(min_, max_, [&](const vector_type& position_, voxel_format& voxel_) {
+                    callback(static_cast<const world_position&>(origin_ + world_position(position_)), voxel_);
+                });
             };
-            
-            ////////////////////////
-            //        VOXEL       //
-            ////////////////////////
 
-            auto node_extent = (component_type)(2);
+            // a box over more chunks than are loaded walks the table instead of the chunk range
+            const uint64_t range_ =
+                static_cast<uint64_t>(last_[0] - first_[0] + 1) *
+                static_cast<uint64_t>(last_[1] - first_[1] + 1) *
+                static_cast<uint64_t>(last_[2] - first_[2] + 1);
 
-            SVO_NODE_RELATION_MATH_IMPL();
-
-            if(!exist)
+            if(range_ > _count)
             {
-                return nullptr;
+                for_each_chunk([&](const chunk_coord& chunk_, tree_type& tree_) {
+                    if(chunk_[0] >= first_[0] && chunk_[1] >= first_[1] && chunk_[2] >= first_[2] && 
+                       chunk_[0] <= last_[0]  && chunk_[1] <= last_[1]  && chunk_[2] <= last_[2]) {
+                        visit_(chunk_, tree_); }
+                });
+                return;
             }
 
-            return &_voxel_pool._blocks[node_->_block_index][index];  
+            for(int32_t z = first_[2]; z <= last_[2]; ++z) {
+                for(int32_t y = first_[1]; y <= last_[1]; ++y) {
+                    for(int32_t x = first_[0]; x <= last_[0]; ++x) {
+                        const chunk_coord chunk_{x, y, z};
+                        if(tree_type* tree_ = find_chunk(chunk_)) {
+                            visit_(chunk_, *tree_); }
+                    }
+                }
+            }
         }
 
-        bool dealloc(const vector_type& voxel_position)
+        ////////////////////////
+        // chunks are stepped through front to back along the ray (3D DDA on the chunk grid)
+        // and tree::raycast runs on the loaded ones, the first chunk with a hit holds the
+        // nearest hit, origin and distance are in world voxel units, the ray is clipped to 
+        // the box around the loaded chunks so the walk ends where that box does
+        ////////////////////////
+        [[nodiscard]]
+        raycast_hit raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance)
         {
-            const bool overflow = 
-            voxel_position[0] >= BOUNDS[0] || 
-            voxel_position[1] >= BOUNDS[1] || 
-            voxel_position[2] >= BOUNDS[2]; 
-
-            if constexpr (DETAILS._discard_overflow){   
-                if(overflow) { return false; } 
-            } else {
-                assert(!overflow);
-            }
-
-            uint8_t depth_ = 0;
-            std::array<node_format*, MAX_DEPTH> path_{};
-            std::array<uint8_t, MAX_DEPTH> child_bits{};
-            auto voxel = 
-                get_traced(
-                    voxel_position, 
-                    &path_[0], 
-                    &child_bits[0], 
-                    &depth_);
-            
-            if(!voxel) {
-                return false;
+            raycast_hit hit_{};
+
+            const float length_ = glm::length(direction);
+            if(_count == 0 || !(length_ > 0.0f)) {
+                return hit_; }
+            const glm::vec3 direction_ = direction / length_;
+
+            update_chunk_bounds();
+            const glm::vec3 box_min_(chunk_origin(_chunk_min));
+            const glm::vec3 box_max_(chunk_origin(_chunk_max + chunk_coord(1, 1, 1)));
+            float t_enter_ = 0.0f;
+            float t_exit_  = max_distance;
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                if(direction_[axis_] != 0.0f) {
+                    const float t_min_ = (box_min_[axis_] - origin[axis_]) / direction_[axis_];
+                    const float t_max_ = (box_max_[axis_] - origin[axis_]) / direction_[axis_];
+                    t_enter_ = std::max(t_enter_, std::min(t_min_, t_max_));
+                    t_exit_  = std::min(t_exit_,  std::max(t_min_, t_max_));
+                } else if(origin[axis_] < box_min_[axis_] || origin[axis_] >= box_max_[axis_]) {
+                    return hit_; }
             }
-            
-            auto& voxel_mask = path_[depth_]->_mask;
-            voxel_mask &= ~child_bits[depth_];
-            if(voxel_mask != 0){
-                return true;
+            // also false for a NaN max distance
+            if(!(t_enter_ <= t_exit_)) {
+                return hit_; }
+
+            // the entry point may round onto a neighbour outside the box
+            chunk_coord chunk_ = chunk_of(world_position(glm::floor(origin + direction_ * t_enter_)));
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                chunk_[axis_] = std::clamp(chunk_[axis_], _chunk_min[axis_], _chunk_max[axis_]); }
+
+            std::array<int32_t, 3> step_{};
+            glm::vec3 t_max_{};
+            glm::vec3 t_delta_{};
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_)
+            {
+                const auto extent_ = static_cast<float>(CHUNK_EXTENT[axis_]);
+                const auto lower_  = static_cast<float>(chunk_[axis_]) * extent_;
+                if(direction_[axis_] > 0.0f) {
+                    step_[axis_]    = 1;
+                    t_max_[axis_]   = (lower_ + extent_ - origin[axis_]) / direction_[axis_];
+                    t_delta_[axis_] = extent_ / direction_[axis_];
+                } else if(direction_[axis_] < 0.0f) {
+                    step_[axis_]    = -1;
+                    t_max_[axis_]   = (lower_ - origin[axis_]) / direction_[axis_];
+                    t_delta_[axis_] = -extent_ / direction_[axis_];
+                } else {
+                    t_max_[axis_]   = std::numeric_limits<float>::infinity();
+                    t_delta_[axis_] = std::numeric_limits<float>::infinity();
+                }
             }
 
-            // # if we got here, we can dealloc the whole voxel block
+            for(float t_ = t_enter_; t_ <= t_exit_; )
+            {
+                if(tree_type* tree_ = find_chunk(chunk_))
+                {
+                    const world_position origin_ = chunk_origin(chunk_);
+                    const auto local_hit_ = tree_->raycast(origin - glm::vec3(origin_), direction_, max_distance);
+                    if(local_hit_._voxel != nullptr) {
+                        hit_._voxel    = local_hit_._voxel;
+                        hit_._position = origin_ + world_position(local_hit_._position);
+                        hit_._face     = local_hit_._face;
+                        hit_._distance = local_hit_._distance;
+                        return hit_;
+                    }
+                }
 
-            ///////////////////////////
-            //  DEALLOC VOXEL BLOCK  //
-            ///////////////////////////
-            
-            _voxel_pool.dealloc(path_[depth_]->_block_index);
-            path_[depth_-1]->_mask &= ~child_bits[depth_-1];
-            --depth_;
-            
-            ///////////////////////////
-            //  DEALLOC NODE BLOCKS  //
-            ///////////////////////////
-            
-            // traverse up, root node excluded
-            for(; depth_ >= 1; --depth_){
-                if(path_[depth_]->_mask != 0) { 
+                const uint32_t axis_ = t_max_[0] < t_max_[1] ?
+                    (t_max_[0] < t_max_[2] ? 0u : 2u) :
+                    (t_max_[1] < t_max_[2] ? 1u : 2u);
+                t_ = t_max_[axis_];
+                chunk_[axis_] += step_[axis_];
+                t_max_[axis_] += t_delta_[axis_];
+
+                // stepping out of the box, far t_ may no longer grow with t_delta_
+                if(chunk_[axis_] < _chunk_min[axis_] || chunk_[axis_] > _chunk_max[axis_]) {
                     break; }
-                _node_pool.dealloc(path_[depth_]->_block_index);
-                path_[depth_-1]->_mask &= ~child_bits[depth_-1];
             }
+            return hit_;
+        }
 
-            return true;
+        ////////////////////////
+        // same layout as tree::get_neighborhood, a block inside a single chunk is fetched by
+        // that chunk's tree in one go, blocks over a chunk border cell by cell
+        ////////////////////////
+        void get_neighborhood(const world_position& voxel_position, voxel_format** out)
+        {
+            const chunk_coord chunk_ = chunk_of(voxel_position);
+            if(is_interior(voxel_position, chunk_))
+            {
+                tree_type* tree_ = find_chunk(chunk_);
+                if(tree_ == nullptr) {
+                    std::fill(out, out + TREE_T::NEIGHBORHOOD_SIZE, nullptr);
+                    return;
+                }
+                tree_->get_neighborhood(local_position(voxel_position, chunk_), out);
+                return;
+            }
+
+            for(int32_t z = -1; z <= 1; ++z) {
+                for(int32_t y = -1; y <= 1; ++y) {
+                    for(int32_t x = -1; x <= 1; ++x) {
+                        out[(x + 1) + 3 * (y + 1) + 9 * (z + 1)] = get(voxel_position + world_position(x, y, z)); }
+                }
+            }
         }
 
-        voxel_format* get_traced(const vector_type& voxel_position, node_format** node_path, uint8_t* child_bits, uint8_t* reached_depth)
+        // same order as tree::get_face_neighborhood, -x, +x, -y, +y, -z, +z
+        void get_face_neighborhood(const world_position& voxel_position, voxel_format** out)
         {
-            const bool overflow = 
-            voxel_position[0] >= BOUNDS[0] || 
-            voxel_position[1] >= BOUNDS[1] || 
-            voxel_position[2] >= BOUNDS[2]; 
+            const chunk_coord chunk_ = chunk_of(voxel_position);
+            if(is_interior(voxel_position, chunk_))
+            {
+                tree_type* tree_ = find_chunk(chunk_);
+                if(tree_ == nullptr) {
+                    std::fill(out, out + TREE_T::FACE_NEIGHBORHOOD_SIZE, nullptr);
+                    return;
+                }
+                tree_->get_face_neighborhood(local_position(voxel_position, chunk_), out);
+                return;
+            }
 
-            if constexpr (DETAILS._discard_overflow){   
-                if(overflow) { return nullptr; } 
-            } else {
-                assert(!overflow);
+            for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                world_position offset_{};
+                offset_[axis_] = 1;
+                out[axis_ * 2]     = get(voxel_position - offset_);
+                out[axis_ * 2 + 1] = get(voxel_position + offset_);
             }
+        }
 
-            vector_type voxel_transformed; 
+    private:
 
-            // x2 even space
-            voxel_transformed = voxel_position;
-            voxel_transformed *= 2; 
-            
-            node_format* node_ = &_root_node;
-        
-            // root node origin is always zero
-            vector_type node_position{0,0,0}; 
+        inline static constexpr size_t
+        MIN_SLOTS = 16;
 
-            ////////////////////////
-            // TRAVERSE NODE TREE //
-            ////////////////////////
-            
-            LOOP_UNROLL
-            for(int i = 0; i < MAX_DEPTH-1; ++i) 
-            {
-                const auto depth_ = i;
+        struct chunk_slot
+        {
+            chunk_coord
+            _coord{};
+
+            // empty slot when null
+            std::unique_ptr<tree_type>
+            _chunk{};
+        };
 
-                const auto node_extent = (component_type)(AXIS_WIDTH >> depth_);
+        static size_t hash(const chunk_coord& chunk_)
+        {
+            uint64_t hash_ = static_cast<uint64_t>(static_cast<uint32_t>(chunk_[0])) * 0x9E3779B97F4A7C15ull;
+            hash_ ^= static_cast<uint64_t>(static_cast<uint32_t>(chunk_[1])) * 0xC2B2AE3D27D4EB4Full;
+            hash_ ^= static_cast<uint64_t>(static_cast<uint32_t>(chunk_[2])) * 0x165667B19E3779F9ull;
+            return static_cast<size_t>(hash_ ^ (hash_ >> 32));
+        }
 
-                SVO_NODE_RELATION_MATH_IMPL();
+        // slot holding chunk_, or the empty slot ending its probe sequence
+        size_t slot_of(const chunk_coord& chunk_) const
+        {
+            const size_t mask_ = _slots.size() - 1;
+            size_t i = hash(chunk_) & mask_;
+            while(_slots[i]._chunk && _slots[i]._coord != chunk_) {
+                i = (i + 1) & mask_; }
+            return i;
+        }
 
-                if(!exist){
-                    return nullptr;
+        tree_type& insert(const chunk_coord& chunk_, std::unique_ptr<tree_type> tree_)
+        {
+            // load factor stays at or below 1/2, probe sequences remain short
+            if((_count + 1) * 2 > _slots.size())
+            {
+                std::vector<chunk_slot> slots_(std::max(MIN_SLOTS, _slots.size() * 2));
+                slots_.swap(_slots);
+                for(auto& slot_ : slots_) {
+                    if(slot_._chunk) {
+                        _slots[slot_of(slot_._coord)] = std::move(slot_); }
                 }
+            }
 
-                ////////////////////////
-                //        TRACE       //
-                ////////////////////////
+            auto& slot_ = _slots[slot_of(chunk_)];
+            assert(!slot_._chunk);
+            slot_ = {chunk_, std::move(tree_)};
+            if(_count == 0) {
+                _chunk_min = chunk_;
+                _chunk_max = chunk_;
+                _bounds_stale = false;
+            } else {
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    _chunk_min[axis_] = std::min(_chunk_min[axis_], chunk_[axis_]);
+                    _chunk_max[axis_] = std::max(_chunk_max[axis_], chunk_[axis_]); }
+            }
+            ++_count;
+            return *slot_._chunk;
+        }
 
-                child_bits[depth_] = child_bit;
-                node_path [depth_] = node_;
-                *reached_depth = depth_;
+        // inserts only grow the box, after a detach it is rebuilt on the next use
+        void update_chunk_bounds()
+        {
+            if(!_bounds_stale) {
+                return; }
+            _bounds_stale = false;
+            _chunk_min = chunk_coord(std::numeric_limits<int32_t>::max());
+            _chunk_max = chunk_coord(std::numeric_limits<int32_t>::min());
+            for_each_chunk([&](const chunk_coord& chunk_, tree_type&) {
+                for(uint32_t axis_ = 0; axis_ < 3; ++axis_) {
+                    _chunk_min[axis_] = std::min(_chunk_min[axis_], chunk_[axis_]);
+                    _chunk_max[axis_] = std::max(_chunk_max[axis_], chunk_[axis_]); }
+            });
+        }
 
-                auto& node_block_ = _node_pool._blocks[node_->_block_index];
-                node_ = &node_block_[index]; 
-                node_position = next_node_position;
-            };
+        static vector_type local_position(const world_position& voxel_position, const chunk_coord& chunk_)
+        {
+            return vector_type(voxel_position - chunk_origin(chunk_));
+        }
 
-            ////////////////////////
-            //        VOXEL       //
-            ////////////////////////
+        static bool is_interior(const world_position& voxel_position, const chunk_coord& chunk_)
+        {
+            const world_position local_ = voxel_position - chunk_origin(chunk_);
+            return
+                local_[0] > 0 && local_[0] < CHUNK_EXTENT[0] - 1 &&
+                local_[1] > 0 && local_[1] < CHUNK_EXTENT[1] - 1 &&
+                local_[2] > 0 && local_[2] < CHUNK_EXTENT[2] - 1;
+        }
 
-            auto node_extent = (component_type)(2);
+        std::vector<chunk_slot>
+        _slots{};
 
-            SVO_NODE_RELATION_MATH_IMPL();
+        size_t
+        _count{};
 
-            if(!exist)
-            {
-                return nullptr;
-            }
+        chunk_coord
+        _cached_coord{};
 
-            ////////////////////////
-            //        TRACE       //
-            ////////////////////////
+        tree_type*
+        _cached_chunk{};
 
-            constexpr auto DEPTH_END =  MAX_DEPTH-1;
-            child_bits [DEPTH_END] = child_bit;
-            node_path  [DEPTH_END] = node_;
-            *reached_depth = DEPTH_END;
+        // box around the loaded chunks, for raycast()
+        chunk_coord
+        _chunk_min{};
 
-            return &_voxel_pool._blocks[node_->_block_index][index];  
-        }
+        chunk_coord
+        _chunk_max{};
+
+        bool
+        _bounds_stale{};
+
+        load_hook
+        _load_hook{};
+
+        unload_hook
+        _unload_hook{};
     };
 }
 